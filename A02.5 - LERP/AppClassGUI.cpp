@@ -31,6 +31,7 @@ void Application::DrawGUI(void)
 			ImGui::TextColored(v4Color, m_sProgrammer.c_str());
 			ImGui::Text("FrameRate: %.2f [FPS] -> %.3f [ms/frame]\n",
 				ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+			ImGui::Text("GUI: %.3f [ms/frame]\n", gui.m_dRenderTime);
 			ImGui::Text("Control:\n");
 			ImGui::Text("   WASD: Movement\n");
 			ImGui::Text("	 F1: Perspective\n");
@@ -111,6 +112,8 @@ void Application::RenderDrawLists(ImDrawData* draw_data)
 	int fb_height = (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y);
 	if (fb_width == 0 || fb_height == 0)
 		return;
+	SystemSingleton* pSystem = SystemSingleton::GetInstance();
+	pSystem->StartClock(Application::gui.m_uRenderClock);
 	draw_data->ScaleClipRects(io.DisplayFramebufferScale);
 
 	// Backup GL state
@@ -156,17 +159,64 @@ void Application::RenderDrawLists(ImDrawData* draw_data)
 	glUniformMatrix4fv(Application::gui.m_nProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 	glBindVertexArray(Application::gui.m_uVAO);
 
+	// Upload all the command lists at once, the buffers only grow when a frame needs more than the
+	// high-water mark, mapping with invalidate orphans last frame's storage so the driver does not stall
+	GLsizeiptr nVertexSize = (GLsizeiptr)draw_data->TotalVtxCount * sizeof(ImDrawVert);
+	GLsizeiptr nIndexSize = (GLsizeiptr)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+	glBindBuffer(GL_ARRAY_BUFFER, Application::gui.m_uVBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Application::gui.m_uElements);
+	if (nVertexSize > Application::gui.m_nVBOSize)
+	{
+		Application::gui.m_nVBOSize = nVertexSize + nVertexSize / 2;
+		glBufferData(GL_ARRAY_BUFFER, Application::gui.m_nVBOSize, NULL, GL_STREAM_DRAW);
+	}
+	if (nIndexSize > Application::gui.m_nElementsSize)
+	{
+		Application::gui.m_nElementsSize = nIndexSize + nIndexSize / 2;
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, Application::gui.m_nElementsSize, NULL, GL_STREAM_DRAW);
+	}
+	if (nVertexSize > 0 && nIndexSize > 0)
+	{
+		ImDrawVert* pVertex = (ImDrawVert*)glMapBufferRange(GL_ARRAY_BUFFER, 0, nVertexSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		ImDrawIdx* pIndex = (ImDrawIdx*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, nIndexSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		bool bVertexWritten = pVertex && pIndex;
+		bool bIndexWritten = bVertexWritten;
+		for (int n = 0; bVertexWritten && n < draw_data->CmdListsCount; n++)
+		{
+			const ImDrawList* cmd_list = draw_data->CmdLists[n];
+			memcpy(pVertex, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+			memcpy(pIndex, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+			pVertex += cmd_list->VtxBuffer.Size;
+			pIndex += cmd_list->IdxBuffer.Size;
+		}
+		if (pVertex && glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+			bVertexWritten = false;
+		if (pIndex && glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER) == GL_FALSE)
+			bIndexWritten = false;
+
+		//the mapping failed or its contents were lost (glUnmapBuffer returns false), send it the slow way
+		GLintptr nVertexByte = 0;
+		GLintptr nIndexByte = 0;
+		for (int n = 0; (!bVertexWritten || !bIndexWritten) && n < draw_data->CmdListsCount; n++)
+		{
+			const ImDrawList* cmd_list = draw_data->CmdLists[n];
+			GLsizeiptr nListVertexSize = (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+			GLsizeiptr nListIndexSize = (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+			if (!bVertexWritten)
+				glBufferSubData(GL_ARRAY_BUFFER, nVertexByte, nListVertexSize, (const GLvoid*)cmd_list->VtxBuffer.Data);
+			if (!bIndexWritten)
+				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, nIndexByte, nListIndexSize, (const GLvoid*)cmd_list->IdxBuffer.Data);
+			nVertexByte += nListVertexSize;
+			nIndexByte += nListIndexSize;
+		}
+	}
+
+	// Every list draws from its own offset in the shared buffers
+	GLint nVertexOffset = 0;
+	const ImDrawIdx* idx_buffer_offset = 0;
 	for (int n = 0; n < draw_data->CmdListsCount; n++)
 	{
 		const ImDrawList* cmd_list = draw_data->CmdLists[n];
-		const ImDrawIdx* idx_buffer_offset = 0;
-
-		glBindBuffer(GL_ARRAY_BUFFER, Application::gui.m_uVBO);
-		glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Application::gui.m_uElements);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
-
 		for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
 		{
 			const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
@@ -178,10 +228,11 @@ void Application::RenderDrawLists(ImDrawData* draw_data)
 			{
 				glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
 				glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-				glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);
+				glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset, nVertexOffset);
 			}
 			idx_buffer_offset += pcmd->ElemCount;
 		}
+		nVertexOffset += cmd_list->VtxBuffer.Size;
 	}
 
 	// Restore modified GL state
@@ -199,6 +250,8 @@ void Application::RenderDrawLists(ImDrawData* draw_data)
 	if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
 	glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
 	glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+
+	Application::gui.m_dRenderTime = pSystem->GetDeltaTime(Application::gui.m_uRenderClock) * 1000.0;
 }
 bool Application::CreateFontsTexture()
 {
@@ -364,6 +417,7 @@ void Application::InitIMGUI(void)
 
 	//Setup clock
 	gui.m_nClock = m_pSystem->GenClock();
+	gui.m_uRenderClock = m_pSystem->GenClock();
 }
 void Application::ShutdownGUI(void)
 {
@@ -371,6 +425,7 @@ void Application::ShutdownGUI(void)
 	if (gui.m_uVBO) glDeleteBuffers(1, &gui.m_uVBO);
 	if (gui.m_uElements) glDeleteBuffers(1, &gui.m_uElements);
 	gui.m_uVAO = gui.m_uVBO = gui.m_uElements = 0;
+	gui.m_nVBOSize = gui.m_nElementsSize = 0;
 
 	if (gui.m_nShader && gui.m_nVertHandle) glDetachShader(gui.m_nShader, gui.m_nVertHandle);
 	if (gui.m_nVertHandle) glDeleteShader(gui.m_nVertHandle);
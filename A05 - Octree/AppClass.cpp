@@ -10,28 +10,89 @@ void Application::InitVariables(void)
 
 	m_pLightMngr->SetPosition(vector3(0.0f, 3.0f, 13.0f), 1); //set the position of first light (0 is reserved for ambient light)
 
-#ifdef DEBUG
-	uint uInstances = 900;
-#else
-	uint uInstances = 1849;
-#endif
-	int nSquare = static_cast<int>(std::sqrt(uInstances));
-	m_uObjects = nSquare * nSquare;
-	uint uIndex = -1;
-	for (int i = 0; i < nSquare; i++)
+	m_uOctantLevels = 1;
+	m_uClock = m_pSystem->GenClock();
+	LoadScene();
+}
+void Application::LoadScene(void)
+{
+	//start from an empty scene
+	SafeDelete(m_pSpatialIndex);
+	m_pRoot = nullptr;
+	while (m_pEntityMngr->GetEntityCount() > 0)
+		m_pEntityMngr->RemoveEntity(m_pEntityMngr->GetEntityCount() - 1);
+
+	if (m_uScene == 1)
 	{
-		for (int j = 0; j < nSquare; j++)
+		//VoxelDodge layout, a flat field of cubes scaled 2x
+		m_uObjects = 100;
+		for (uint i = 0; i < m_uObjects; i++)
 		{
-			uIndex++;
 			m_pEntityMngr->AddEntity("Minecraft\\Cube.obj");
-			vector3 v3Position = vector3(glm::sphericalRand(34.0f));
+			vector3 v3Position = vector3(glm::sphericalRand(12.0f));
+			v3Position.y = 0.0f;
 			matrix4 m4Position = glm::translate(v3Position);
-			m_pEntityMngr->SetModelMatrix(m4Position);
+			m_pEntityMngr->SetModelMatrix(m4Position * glm::scale(vector3(2.0f)));
 		}
 	}
-	m_uOctantLevels = 1;
-	m_pRoot = new MyOctant(m_uOctantLevels, 5);
-	m_pEntityMngr->Update();
+	else
+	{
+#ifdef DEBUG
+		uint uInstances = 900;
+#else
+		uint uInstances = 1849;
+#endif
+		int nSquare = static_cast<int>(std::sqrt(uInstances));
+		m_uObjects = nSquare * nSquare;
+		for (int i = 0; i < nSquare; i++)
+		{
+			for (int j = 0; j < nSquare; j++)
+			{
+				m_pEntityMngr->AddEntity("Minecraft\\Cube.obj");
+				vector3 v3Position = vector3(glm::sphericalRand(34.0f));
+				matrix4 m4Position = glm::translate(v3Position);
+				m_pEntityMngr->SetModelMatrix(m4Position);
+			}
+		}
+	}
+
+	BuildSpatialIndex();
+}
+void Application::BuildSpatialIndex(void)
+{
+	SafeDelete(m_pSpatialIndex);
+	m_pRoot = nullptr;
+	m_uOctantID = -1;
+	m_nPicked = -1;
+	m_pEntityMngr->ClearDimensionSetAll();
+
+	//every structure hands its candidate pairs to the entity manager when built
+	m_pSystem->StartClock(m_uClock);
+	switch (m_uIndexType)
+	{
+	default:
+		m_pRoot = new MyOctant(m_uOctantLevels, 5);
+		m_pSpatialIndex = m_pRoot;
+		break;
+	case 1:
+		m_pRoot = new MyOctant(m_uOctantLevels, 5, m_fLooseness);
+		m_pSpatialIndex = m_pRoot;
+		break;
+	case 2:
+		m_pSpatialIndex = new MyAABBTree();
+		break;
+	}
+	m_fBuildTime = m_pSystem->GetDeltaTime(m_uClock) * 1000.0f;
+}
+void Application::PickEntity(void)
+{
+	std::pair<vector3, vector3> ray = m_pCameraMngr->GetClickAndDirectionOnWorldSpace(
+		static_cast<uint>(m_v3Mouse.x), static_cast<uint>(m_v3Mouse.y));
+
+	float fDistance = 0.0f;
+	m_pSystem->StartClock(m_uClock);
+	m_nPicked = m_pSpatialIndex->RayCast(ray.first, ray.second, fDistance);
+	m_fPickTime = m_pSystem->GetDeltaTime(m_uClock) * 1000.0f;
 }
 void Application::Update(void)
 {
@@ -45,7 +106,9 @@ void Application::Update(void)
 	CameraRotation();
 	
 	//Update Entity Manager
+	m_pSystem->StartClock(m_uClock);
 	m_pEntityMngr->Update();
+	m_fCollisionTime = m_pSystem->GetDeltaTime(m_uClock) * 1000.0f;
 
 	//Add objects to render list
 	m_pEntityMngr->AddEntityToRenderList(-1, true);
@@ -55,12 +118,22 @@ void Application::Display(void)
 	// Clear the screen
 	ClearScreen();
 
-	//display octree
-	if (m_uOctantID == -1) {
-		m_pRoot->Display();
+	//display spatial index
+	if (m_uOctantID == -1 || m_pRoot == nullptr) {
+		m_pSpatialIndex->Display();
 	}
 	else
 		m_pRoot->Display(m_uOctantID);
+
+	//highlight the picked entity
+	if (m_nPicked != -1)
+	{
+		MyRigidBody* pRigidBody = m_pEntityMngr->GetRigidBody(m_nPicked);
+		vector3 v3Min = pRigidBody->GetMinGlobal();
+		vector3 v3Max = pRigidBody->GetMaxGlobal();
+		matrix4 m4Box = glm::translate(IDENTITY_M4, (v3Min + v3Max) * 0.5f) * glm::scale(v3Max - v3Min);
+		m_pMeshMngr->AddWireCubeToRenderList(m4Box, C_RED, RENDER_WIRE);
+	}
 	
 	// draw a skybox
 	m_pMeshMngr->AddSkyboxToRenderList();
@@ -79,7 +152,8 @@ void Application::Display(void)
 }
 void Application::Release(void)
 {
-	SafeDelete(m_pRoot);
+	SafeDelete(m_pSpatialIndex);
+	m_pRoot = nullptr;
 
 	//release GUI
 	ShutdownGUI();
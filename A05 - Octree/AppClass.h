@@ -11,6 +11,7 @@ Date: 2017/06
 #include "imgui\ImGuiObject.h"
 
 #include "MyOctant.h"
+#include "MyAABBTree.h"
 
 #include "Simplex\Physics\Octant.h"
 
@@ -20,10 +21,19 @@ namespace Simplex
 class Application
 {
 	MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager
-	MyOctant* m_pRoot = nullptr; //Root of the octree
+	MySpatialIndex* m_pSpatialIndex = nullptr; //Broad phase structure in use
+	MyOctant* m_pRoot = nullptr; //Root of the octree, same object as the spatial index if it is an octree
 	uint m_uOctantID = -1; //Index of Octant to display
 	uint m_uObjects = 0; //Number of objects in the scene
 	uint m_uOctantLevels = 0; //Number of levels in the octree
+	uint m_uIndexType = 0; //Spatial index to use: 0 octree, 1 loose octree, 2 AABB tree
+	float m_fLooseness = 2.0f; //How much bigger than their cell the loose octants are
+	uint m_uScene = 0; //Layout of the scene: 0 sphere of cubes (A05), 1 field of 2x cubes (VoxelDodge)
+	uint m_uClock = 0; //Clock used to time the broad phase
+	float m_fBuildTime = 0.0f; //Milliseconds spent building the spatial index and its pairs
+	float m_fCollisionTime = 0.0f; //Milliseconds spent testing the candidate pairs last frame
+	int m_nPicked = -1; //Entity under the last left click, -1 if none
+	float m_fPickTime = 0.0f; //Milliseconds spent on the last pick ray cast
 private:
 	String m_sProgrammer = "Emily Turner - ekt6170@g.rit.edu"; //programmer
 
@@ -139,6 +149,24 @@ private:
 	OUTPUT: ---
 	*/
 	void Release(void);
+	/*
+	USAGE: Replaces the entities with the ones of the current scene layout
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void LoadScene(void);
+	/*
+	USAGE: Replaces the spatial index with one of the current type and times its construction
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void BuildSpatialIndex(void);
+	/*
+	USAGE: Casts a ray from the camera through the mouse and picks the first entity it hits
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void PickEntity(void);
 #pragma endregion
 
 #pragma region Main Loop
@@ -19,6 +19,8 @@ void Application::ProcessMousePressed(sf::Event a_event)
 	default: break;
 	case sf::Mouse::Button::Left:
 		gui.m_bMousePressed[0] = true;
+		if (!gui.io.WantCaptureMouse)
+			PickEntity();
 		break;
 	case sf::Mouse::Button::Middle:
 		gui.m_bMousePressed[1] = true;
@@ -114,39 +116,39 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 	case sf::Keyboard::PageUp:
 		++m_uOctantID;
 		
-		if (m_uOctantID >= m_pRoot->GetOctantCount())
+		if (m_pRoot == nullptr || m_uOctantID >= m_pRoot->GetOctantCount())
 			m_uOctantID = - 1;
 		
 		break;
 	case sf::Keyboard::PageDown:
 		--m_uOctantID;
 		
-		if (m_uOctantID >= m_pRoot->GetOctantCount())
+		if (m_pRoot == nullptr || m_uOctantID >= m_pRoot->GetOctantCount())
 			m_uOctantID = - 1;
 		
 		break;
 	case sf::Keyboard::Add:
 		if (m_uOctantLevels < 4)
 		{
-			m_pEntityMngr->ClearDimensionSetAll();
 			++m_uOctantLevels;
-			
-			SafeDelete(m_pRoot);
-			m_pRoot = new MyOctant(m_uOctantLevels, 5);
-			
+			BuildSpatialIndex();
 		}
 		break;
 	case sf::Keyboard::Subtract:
 		if (m_uOctantLevels > 0)
 		{
-			m_pEntityMngr->ClearDimensionSetAll();
 			--m_uOctantLevels;
-			
-			SafeDelete(m_pRoot);
-			m_pRoot = new MyOctant(m_uOctantLevels, 5);
-			
+			BuildSpatialIndex();
 		}
 		break;
+	case sf::Keyboard::I:
+		m_uIndexType = (m_uIndexType + 1) % 3;
+		BuildSpatialIndex();
+		break;
+	case sf::Keyboard::L:
+		m_uScene = (m_uScene + 1) % 2;
+		LoadScene();
+		break;
 	case sf::Keyboard::LShift:
 	case sf::Keyboard::RShift:
 		m_bModifier = false;
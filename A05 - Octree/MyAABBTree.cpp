@@ -0,0 +1,530 @@
+#include "MyAABBTree.h"
+using namespace Simplex;
+//  MyAABBTree
+void Simplex::MyAABBTree::Init(void)
+{
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_fMargin = 0.0f;
+	m_nRoot = -1;
+	m_nFreeNode = -1;
+	m_uNodeCount = 0;
+	m_uNodeCapacity = 0;
+	m_pNodeArray = nullptr;
+	m_uEntityCount = 0;
+	m_nLeafArray = nullptr;
+}
+void Simplex::MyAABBTree::Swap(MyAABBTree& other)
+{
+	std::swap(m_pMeshMngr, other.m_pMeshMngr);
+	std::swap(m_pEntityMngr, other.m_pEntityMngr);
+	std::swap(m_fMargin, other.m_fMargin);
+	std::swap(m_nRoot, other.m_nRoot);
+	std::swap(m_nFreeNode, other.m_nFreeNode);
+	std::swap(m_uNodeCount, other.m_uNodeCount);
+	std::swap(m_uNodeCapacity, other.m_uNodeCapacity);
+	std::swap(m_pNodeArray, other.m_pNodeArray);
+	std::swap(m_uEntityCount, other.m_uEntityCount);
+	std::swap(m_nLeafArray, other.m_nLeafArray);
+}
+void Simplex::MyAABBTree::Release(void)
+{
+	if (m_pNodeArray)
+	{
+		delete[] m_pNodeArray;
+		m_pNodeArray = nullptr;
+	}
+	if (m_nLeafArray)
+	{
+		delete[] m_nLeafArray;
+		m_nLeafArray = nullptr;
+	}
+	m_nRoot = -1;
+	m_nFreeNode = -1;
+	m_uNodeCount = 0;
+	m_uNodeCapacity = 0;
+	m_uEntityCount = 0;
+}
+//The big 3
+Simplex::MyAABBTree::MyAABBTree(float a_fMargin)
+{
+	Init();
+	m_fMargin = a_fMargin;
+	Build();
+	ConstructPairList();
+}
+Simplex::MyAABBTree::MyAABBTree(MyAABBTree const& other)
+{
+	Init();
+	m_fMargin = other.m_fMargin;
+	m_nRoot = other.m_nRoot;
+	m_nFreeNode = other.m_nFreeNode;
+	m_uNodeCount = other.m_uNodeCount;
+	m_uNodeCapacity = other.m_uNodeCapacity;
+	m_uEntityCount = other.m_uEntityCount;
+	if (other.m_pNodeArray)
+	{
+		m_pNodeArray = new MyAABBNode[m_uNodeCapacity];
+		std::copy(other.m_pNodeArray, other.m_pNodeArray + m_uNodeCapacity, m_pNodeArray);
+	}
+	if (other.m_nLeafArray)
+	{
+		m_nLeafArray = new int[m_uEntityCount];
+		memcpy(m_nLeafArray, other.m_nLeafArray, sizeof(int) * m_uEntityCount);
+	}
+}
+MyAABBTree& Simplex::MyAABBTree::operator=(MyAABBTree const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyAABBTree temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+Simplex::MyAABBTree::~MyAABBTree() { Release(); }
+//--- Node pool
+int Simplex::MyAABBTree::AllocateNode(void)
+{
+	//no free nodes, grow the pool and chain the new ones in the free list
+	if (m_nFreeNode == -1)
+	{
+		uint uCapacity = m_uNodeCapacity == 0 ? 16 : m_uNodeCapacity * 2;
+		MyAABBNode* pTemp = new MyAABBNode[uCapacity];
+		if (m_pNodeArray)
+		{
+			std::copy(m_pNodeArray, m_pNodeArray + m_uNodeCapacity, pTemp);
+			delete[] m_pNodeArray;
+			m_pNodeArray = nullptr;
+		}
+		m_pNodeArray = pTemp;
+		for (uint i = m_uNodeCapacity; i < uCapacity; ++i)
+		{
+			m_pNodeArray[i].m_nParent = (i + 1 < uCapacity) ? static_cast<int>(i + 1) : -1;
+		}
+		m_nFreeNode = static_cast<int>(m_uNodeCapacity);
+		m_uNodeCapacity = uCapacity;
+	}
+
+	int nNode = m_nFreeNode;
+	m_nFreeNode = m_pNodeArray[nNode].m_nParent;
+	m_pNodeArray[nNode] = MyAABBNode();
+	++m_uNodeCount;
+	return nNode;
+}
+void Simplex::MyAABBTree::FreeNode(int a_nNode)
+{
+	m_pNodeArray[a_nNode] = MyAABBNode();
+	m_pNodeArray[a_nNode].m_nParent = m_nFreeNode;
+	m_nFreeNode = a_nNode;
+	--m_uNodeCount;
+}
+//--- Methods
+float Simplex::MyAABBTree::SurfaceArea(vector3 a_v3Min, vector3 a_v3Max)
+{
+	vector3 v3Size = a_v3Max - a_v3Min;
+	return 2.0f * (v3Size.x * v3Size.y + v3Size.y * v3Size.z + v3Size.z * v3Size.x);
+}
+void Simplex::MyAABBTree::Build(void)
+{
+	m_uEntityCount = m_pEntityMngr->GetEntityCount();
+	if (m_uEntityCount == 0)
+		return;
+
+	m_nLeafArray = new int[m_uEntityCount];
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		InsertEntity(i);
+	}
+}
+void Simplex::MyAABBTree::InsertEntity(uint a_uEntity)
+{
+	MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(a_uEntity)->GetRigidBody();
+	int nLeaf = AllocateNode();
+	m_pNodeArray[nLeaf].m_v3Min = pRigidBody->GetMinGlobal() - vector3(m_fMargin);
+	m_pNodeArray[nLeaf].m_v3Max = pRigidBody->GetMaxGlobal() + vector3(m_fMargin);
+	m_pNodeArray[nLeaf].m_nEntity = static_cast<int>(a_uEntity);
+	m_nLeafArray[a_uEntity] = nLeaf;
+	InsertLeaf(nLeaf);
+}
+void Simplex::MyAABBTree::InsertLeaf(int a_nLeaf)
+{
+	//first leaf is the root
+	if (m_nRoot == -1)
+	{
+		m_nRoot = a_nLeaf;
+		m_pNodeArray[a_nLeaf].m_nParent = -1;
+		return;
+	}
+
+	//walk down to the sibling where adding the leaf grows the surface area the least
+	vector3 v3Min = m_pNodeArray[a_nLeaf].m_v3Min;
+	vector3 v3Max = m_pNodeArray[a_nLeaf].m_v3Max;
+	int nIndex = m_nRoot;
+	while (m_pNodeArray[nIndex].m_nLeft != -1)
+	{
+		MyAABBNode& node = m_pNodeArray[nIndex];
+		float fArea = SurfaceArea(node.m_v3Min, node.m_v3Max);
+		float fCombined = SurfaceArea(glm::min(node.m_v3Min, v3Min), glm::max(node.m_v3Max, v3Max));
+		//cost of making a new parent for this node and the leaf
+		float fCost = 2.0f * fCombined;
+		//cost every level below pays for growing this node
+		float fInheritance = 2.0f * (fCombined - fArea);
+
+		float fChildCost[2];
+		int nChild[2] = { node.m_nLeft, node.m_nRight };
+		for (uint i = 0; i < 2; ++i)
+		{
+			MyAABBNode& child = m_pNodeArray[nChild[i]];
+			float fChildCombined = SurfaceArea(glm::min(child.m_v3Min, v3Min), glm::max(child.m_v3Max, v3Max));
+			if (child.m_nLeft == -1)
+				fChildCost[i] = fChildCombined + fInheritance;
+			else
+				fChildCost[i] = fChildCombined - SurfaceArea(child.m_v3Min, child.m_v3Max) + fInheritance;
+		}
+
+		if (fCost < fChildCost[0] && fCost < fChildCost[1])
+			break;
+
+		nIndex = fChildCost[0] < fChildCost[1] ? nChild[0] : nChild[1];
+	}
+
+	//the sibling and the leaf hang from a new parent, allocating may move the pool
+	int nSibling = nIndex;
+	int nParent = AllocateNode();
+	int nOldParent = m_pNodeArray[nSibling].m_nParent;
+	m_pNodeArray[nParent].m_nParent = nOldParent;
+	m_pNodeArray[nParent].m_nLeft = nSibling;
+	m_pNodeArray[nParent].m_nRight = a_nLeaf;
+	m_pNodeArray[nSibling].m_nParent = nParent;
+	m_pNodeArray[a_nLeaf].m_nParent = nParent;
+
+	if (nOldParent == -1)
+		m_nRoot = nParent;
+	else if (m_pNodeArray[nOldParent].m_nLeft == nSibling)
+		m_pNodeArray[nOldParent].m_nLeft = nParent;
+	else
+		m_pNodeArray[nOldParent].m_nRight = nParent;
+
+	Refit(nParent);
+}
+void Simplex::MyAABBTree::RemoveLeaf(int a_nLeaf)
+{
+	if (a_nLeaf == m_nRoot)
+	{
+		m_nRoot = -1;
+		return;
+	}
+
+	//the sibling takes the place of the parent
+	int nParent = m_pNodeArray[a_nLeaf].m_nParent;
+	int nGrandParent = m_pNodeArray[nParent].m_nParent;
+	int nSibling = m_pNodeArray[nParent].m_nLeft == a_nLeaf ? m_pNodeArray[nParent].m_nRight : m_pNodeArray[nParent].m_nLeft;
+
+	m_pNodeArray[nSibling].m_nParent = nGrandParent;
+	if (nGrandParent == -1)
+	{
+		m_nRoot = nSibling;
+	}
+	else
+	{
+		if (m_pNodeArray[nGrandParent].m_nLeft == nParent)
+			m_pNodeArray[nGrandParent].m_nLeft = nSibling;
+		else
+			m_pNodeArray[nGrandParent].m_nRight = nSibling;
+		Refit(nGrandParent);
+	}
+	FreeNode(nParent);
+	m_pNodeArray[a_nLeaf].m_nParent = -1;
+}
+void Simplex::MyAABBTree::Refit(int a_nNode)
+{
+	while (a_nNode != -1)
+	{
+		MyAABBNode& node = m_pNodeArray[a_nNode];
+		MyAABBNode& left = m_pNodeArray[node.m_nLeft];
+		MyAABBNode& right = m_pNodeArray[node.m_nRight];
+		node.m_v3Min = glm::min(left.m_v3Min, right.m_v3Min);
+		node.m_v3Max = glm::max(left.m_v3Max, right.m_v3Max);
+		a_nNode = node.m_nParent;
+	}
+}
+void Simplex::MyAABBTree::Update(void)
+{
+	//entities were added or removed, the leaves no longer match the indices
+	if (m_pEntityMngr->GetEntityCount() != m_uEntityCount)
+	{
+		Release();
+		Build();
+		ConstructPairList();
+		return;
+	}
+
+	//reinsert the entities that left their fat box
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(i)->GetRigidBody();
+		vector3 v3MinG = pRigidBody->GetMinGlobal();
+		vector3 v3MaxG = pRigidBody->GetMaxGlobal();
+		int nLeaf = m_nLeafArray[i];
+		MyAABBNode& leaf = m_pNodeArray[nLeaf];
+		if (glm::all(glm::greaterThanEqual(v3MinG, leaf.m_v3Min)) && glm::all(glm::lessThanEqual(v3MaxG, leaf.m_v3Max)))
+			continue;
+
+		RemoveLeaf(nLeaf);
+		m_pNodeArray[nLeaf].m_v3Min = v3MinG - vector3(m_fMargin);
+		m_pNodeArray[nLeaf].m_v3Max = v3MaxG + vector3(m_fMargin);
+		InsertLeaf(nLeaf);
+	}
+
+	ConstructPairList();
+}
+void Simplex::MyAABBTree::CollectPairs(int a_nNode, int a_nLeaf, std::vector<uint>& a_lPair)
+{
+	MyAABBNode& node = m_pNodeArray[a_nNode];
+	MyAABBNode& leaf = m_pNodeArray[a_nLeaf];
+	if (glm::any(glm::lessThan(node.m_v3Max, leaf.m_v3Min)) || glm::any(glm::greaterThan(node.m_v3Min, leaf.m_v3Max)))
+		return;
+
+	if (node.m_nLeft == -1)
+	{
+		//only from the lower index so each pair is found once
+		if (node.m_nEntity > leaf.m_nEntity)
+		{
+			a_lPair.push_back(static_cast<uint>(leaf.m_nEntity));
+			a_lPair.push_back(static_cast<uint>(node.m_nEntity));
+		}
+		return;
+	}
+
+	CollectPairs(node.m_nLeft, a_nLeaf, a_lPair);
+	CollectPairs(node.m_nRight, a_nLeaf, a_lPair);
+}
+void Simplex::MyAABBTree::ConstructPairList(void)
+{
+	std::vector<uint> lPair;
+	if (m_nRoot != -1)
+	{
+		for (uint i = 0; i < m_uEntityCount; ++i)
+		{
+			CollectPairs(m_nRoot, m_nLeafArray[i], lPair);
+		}
+	}
+	m_pEntityMngr->SetPairList(lPair);
+}
+void Simplex::MyAABBTree::Display(vector3 a_v3Color)
+{
+	if (m_nRoot == -1)
+		return;
+
+	std::vector<int> lStack;
+	lStack.push_back(m_nRoot);
+	while (!lStack.empty())
+	{
+		MyAABBNode& node = m_pNodeArray[lStack.back()];
+		lStack.pop_back();
+		vector3 v3Center = (node.m_v3Min + node.m_v3Max) / 2.0f;
+		vector3 v3Size = node.m_v3Max - node.m_v3Min;
+		m_pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, v3Center) * glm::scale(v3Size), a_v3Color, RENDER_WIRE);
+		if (node.m_nLeft != -1)
+		{
+			lStack.push_back(node.m_nLeft);
+			lStack.push_back(node.m_nRight);
+		}
+	}
+}
+int Simplex::MyAABBTree::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance)
+{
+	vector3 v3Inverse = 1.0f / glm::normalize(a_v3Direction);
+	int nHit = -1;
+	float fClosest = FLT_MAX;
+	float fDistance = 0.0f;
+
+	//min heap of nodes by the distance where the ray enters them
+	typedef std::pair<float, int> NodeHit;
+	std::vector<NodeHit> lHeap;
+	if (m_nRoot != -1 && RayHitsBox(a_v3Origin, v3Inverse, m_pNodeArray[m_nRoot].m_v3Min, m_pNodeArray[m_nRoot].m_v3Max, fClosest, fDistance))
+		lHeap.push_back(NodeHit(fDistance, m_nRoot));
+
+	while (!lHeap.empty())
+	{
+		std::pop_heap(lHeap.begin(), lHeap.end(), std::greater<NodeHit>());
+		NodeHit next = lHeap.back();
+		lHeap.pop_back();
+
+		//every node left starts behind the closest hit
+		if (next.first > fClosest)
+			break;
+
+		MyAABBNode& node = m_pNodeArray[next.second];
+		if (node.m_nLeft == -1)
+		{
+			//the leaf is fat, test the entity itself
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(node.m_nEntity)->GetRigidBody();
+			if (RayHitsBox(a_v3Origin, v3Inverse, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal(), fClosest, fDistance) && fDistance < fClosest)
+			{
+				fClosest = fDistance;
+				nHit = node.m_nEntity;
+			}
+			continue;
+		}
+
+		int nChild[2] = { node.m_nLeft, node.m_nRight };
+		for (uint i = 0; i < 2; ++i)
+		{
+			MyAABBNode& child = m_pNodeArray[nChild[i]];
+			if (RayHitsBox(a_v3Origin, v3Inverse, child.m_v3Min, child.m_v3Max, fClosest, fDistance))
+			{
+				lHeap.push_back(NodeHit(fDistance, nChild[i]));
+				std::push_heap(lHeap.begin(), lHeap.end(), std::greater<NodeHit>());
+			}
+		}
+	}
+
+	if (nHit != -1)
+		a_fDistance = fClosest;
+	return nHit;
+}
+std::vector<uint> Simplex::MyAABBTree::RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction)
+{
+	vector3 v3Inverse = 1.0f / glm::normalize(a_v3Direction);
+	float fDistance = 0.0f;
+	std::vector<std::pair<float, uint>> lHit;
+
+	std::vector<int> lStack;
+	if (m_nRoot != -1)
+		lStack.push_back(m_nRoot);
+	while (!lStack.empty())
+	{
+		MyAABBNode& node = m_pNodeArray[lStack.back()];
+		lStack.pop_back();
+		if (!RayHitsBox(a_v3Origin, v3Inverse, node.m_v3Min, node.m_v3Max, FLT_MAX, fDistance))
+			continue;
+
+		if (node.m_nLeft == -1)
+		{
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(node.m_nEntity)->GetRigidBody();
+			if (RayHitsBox(a_v3Origin, v3Inverse, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal(), FLT_MAX, fDistance))
+				lHit.push_back(std::make_pair(fDistance, static_cast<uint>(node.m_nEntity)));
+			continue;
+		}
+		lStack.push_back(node.m_nLeft);
+		lStack.push_back(node.m_nRight);
+	}
+
+	std::sort(lHit.begin(), lHit.end());
+	std::vector<uint> lEntity;
+	for (uint i = 0; i < lHit.size(); ++i)
+	{
+		lEntity.push_back(lHit[i].second);
+	}
+	return lEntity;
+}
+std::vector<uint> Simplex::MyAABBTree::QueryAABB(vector3 a_v3Min, vector3 a_v3Max)
+{
+	std::vector<uint> lEntity;
+	std::vector<int> lStack;
+	if (m_nRoot != -1)
+		lStack.push_back(m_nRoot);
+	while (!lStack.empty())
+	{
+		MyAABBNode& node = m_pNodeArray[lStack.back()];
+		lStack.pop_back();
+		if (glm::any(glm::lessThan(node.m_v3Max, a_v3Min)) || glm::any(glm::greaterThan(node.m_v3Min, a_v3Max)))
+			continue;
+
+		if (node.m_nLeft == -1)
+		{
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(node.m_nEntity)->GetRigidBody();
+			if (glm::all(glm::lessThanEqual(pRigidBody->GetMinGlobal(), a_v3Max)) && glm::all(glm::greaterThanEqual(pRigidBody->GetMaxGlobal(), a_v3Min)))
+				lEntity.push_back(static_cast<uint>(node.m_nEntity));
+			continue;
+		}
+		lStack.push_back(node.m_nLeft);
+		lStack.push_back(node.m_nRight);
+	}
+
+	std::sort(lEntity.begin(), lEntity.end());
+	return lEntity;
+}
+std::vector<uint> Simplex::MyAABBTree::QuerySphere(vector3 a_v3Center, float a_fRadius)
+{
+	float fRadius2 = a_fRadius * a_fRadius;
+	std::vector<uint> lEntity;
+	std::vector<int> lStack;
+	if (m_nRoot != -1)
+		lStack.push_back(m_nRoot);
+	while (!lStack.empty())
+	{
+		MyAABBNode& node = m_pNodeArray[lStack.back()];
+		lStack.pop_back();
+		if (DistanceToBox2(a_v3Center, node.m_v3Min, node.m_v3Max) > fRadius2)
+			continue;
+
+		if (node.m_nLeft == -1)
+		{
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(node.m_nEntity)->GetRigidBody();
+			if (DistanceToBox2(a_v3Center, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal()) <= fRadius2)
+				lEntity.push_back(static_cast<uint>(node.m_nEntity));
+			continue;
+		}
+		lStack.push_back(node.m_nLeft);
+		lStack.push_back(node.m_nRight);
+	}
+
+	std::sort(lEntity.begin(), lEntity.end());
+	return lEntity;
+}
+std::vector<uint> Simplex::MyAABBTree::QueryNearest(vector3 a_v3Point, uint a_uCount)
+{
+	//nodes are visited closest first until they are farther than the k-th entity found
+	typedef std::pair<float, int> NodeDistance;
+	std::vector<std::pair<float, uint>> lBest; //sorted closest first, at most a_uCount
+	std::vector<NodeDistance> lHeap;
+	if (m_nRoot != -1 && a_uCount > 0)
+		lHeap.push_back(NodeDistance(DistanceToBox2(a_v3Point, m_pNodeArray[m_nRoot].m_v3Min, m_pNodeArray[m_nRoot].m_v3Max), m_nRoot));
+
+	while (!lHeap.empty())
+	{
+		std::pop_heap(lHeap.begin(), lHeap.end(), std::greater<NodeDistance>());
+		NodeDistance next = lHeap.back();
+		lHeap.pop_back();
+
+		float fBound = lBest.size() < a_uCount ? FLT_MAX : lBest.back().first;
+		if (next.first > fBound)
+			break;
+
+		MyAABBNode& node = m_pNodeArray[next.second];
+		if (node.m_nLeft == -1)
+		{
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(node.m_nEntity)->GetRigidBody();
+			std::pair<float, uint> candidate(DistanceToBox2(a_v3Point, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal()), static_cast<uint>(node.m_nEntity));
+			if (candidate.first < fBound)
+			{
+				lBest.insert(std::upper_bound(lBest.begin(), lBest.end(), candidate), candidate);
+				if (lBest.size() > a_uCount)
+					lBest.pop_back();
+			}
+			continue;
+		}
+
+		int nChild[2] = { node.m_nLeft, node.m_nRight };
+		for (uint i = 0; i < 2; ++i)
+		{
+			MyAABBNode& child = m_pNodeArray[nChild[i]];
+			lHeap.push_back(NodeDistance(DistanceToBox2(a_v3Point, child.m_v3Min, child.m_v3Max), nChild[i]));
+			std::push_heap(lHeap.begin(), lHeap.end(), std::greater<NodeDistance>());
+		}
+	}
+
+	std::vector<uint> lEntity;
+	for (uint i = 0; i < lBest.size(); ++i)
+	{
+		lEntity.push_back(lBest[i].second);
+	}
+	return lEntity;
+}
+uint Simplex::MyAABBTree::GetNodeCount(void) { return m_uNodeCount; }
+String Simplex::MyAABBTree::GetName(void) { return "AABB Tree"; }
@@ -0,0 +1,218 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/07
+----------------------------------------------*/
+#ifndef __MYAABBTREE_H_
+#define __MYAABBTREE_H_
+
+#include "MySpatialIndex.h"
+
+namespace Simplex
+{
+
+//Dynamic bounding volume hierarchy over the entities, every leaf is the fat ARBB of one entity
+class MyAABBTree : public MySpatialIndex
+{
+	struct MyAABBNode
+	{
+		vector3 m_v3Min = vector3(0.0f); //minimum corner of the box
+		vector3 m_v3Max = vector3(0.0f); //maximum corner of the box
+		int m_nParent = -1; //parent node, next free node while in the free list
+		int m_nLeft = -1; //left child, -1 for a leaf
+		int m_nRight = -1; //right child, -1 for a leaf
+		int m_nEntity = -1; //index of the entity in the entity manager, leaves only
+	};
+
+	MeshManager* m_pMeshMngr = nullptr; //for displaying the tree
+	MyEntityManager* m_pEntityMngr = nullptr; //entities living in the tree
+
+	float m_fMargin = 0.0f; //how much the leaves grow past the ARBB so small moves do not reinsert
+	int m_nRoot = -1; //root node, -1 if empty
+	int m_nFreeNode = -1; //first unused node of the pool
+	uint m_uNodeCount = 0; //number of nodes in use
+	uint m_uNodeCapacity = 0; //number of nodes allocated in the pool
+	MyAABBNode* m_pNodeArray = nullptr; //node pool
+	uint m_uEntityCount = 0; //number of entities in the tree
+	int* m_nLeafArray = nullptr; //leaf node of each entity
+
+public:
+	/*
+	Usage: Constructor, inserts all the entities of the entity manager and gives it the pairs
+	Arguments: float a_fMargin = 0.5f -> how much the leaves grow past the ARBB of their entity
+	Output: class object instance
+	*/
+	MyAABBTree(float a_fMargin = 0.5f);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyAABBTree(MyAABBTree const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyAABBTree& operator=(MyAABBTree const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyAABBTree(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyAABBTree& other);
+	/*
+	USAGE: Reinserts the entities that moved out of their fat leaf, rebuilds if entities were
+		added or removed from the entity manager, then gives it the new pairs
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Update(void);
+	/*
+	USAGE: Gives the entity manager the pairs of entities whose leaves overlap
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ConstructPairList(void);
+	/*
+	USAGE: Adds the boxes of the tree to the render list
+	ARGUMENTS: vector3 a_v3Color = C_YELLOW -> color of the boxes
+	OUTPUT: ---
+	*/
+	void Display(vector3 a_v3Color = C_YELLOW);
+	/*
+	USAGE: Gets the number of nodes in the tree
+	ARGUMENTS: ---
+	OUTPUT: node count
+	*/
+	uint GetNodeCount(void);
+	/*
+	USAGE: Gets the name of the structure
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	String GetName(void);
+	/*
+	USAGE: Finds the first entity the ray hits, visiting the nodes front to back
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> start of the ray
+	-	vector3 a_v3Direction -> direction of the ray
+	-	float& a_fDistance -> distance from the origin to the hit, untouched if nothing is hit
+	OUTPUT: index of the entity in the entity manager, -1 if nothing is hit
+	*/
+	int RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance);
+	/*
+	USAGE: Finds every entity the ray hits
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> start of the ray
+	-	vector3 a_v3Direction -> direction of the ray
+	OUTPUT: indices of the entities, nearest first
+	*/
+	std::vector<uint> RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction);
+	/*
+	USAGE: Finds the entities whose ARBB overlaps the box
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner of the box
+	-	vector3 a_v3Max -> maximum corner of the box
+	OUTPUT: indices of the entities, sorted
+	*/
+	std::vector<uint> QueryAABB(vector3 a_v3Min, vector3 a_v3Max);
+	/*
+	USAGE: Finds the entities whose ARBB overlaps the sphere
+	ARGUMENTS:
+	-	vector3 a_v3Center -> center of the sphere
+	-	float a_fRadius -> radius of the sphere
+	OUTPUT: indices of the entities, sorted
+	*/
+	std::vector<uint> QuerySphere(vector3 a_v3Center, float a_fRadius);
+	/*
+	USAGE: Finds the entities whose ARBB is closest to the point
+	ARGUMENTS:
+	-	vector3 a_v3Point -> point to measure from
+	-	uint a_uCount -> how many entities to find
+	OUTPUT: indices of the entities, nearest first
+	*/
+	std::vector<uint> QueryNearest(vector3 a_v3Point, uint a_uCount);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	Usage: Inserts every entity of the entity manager in an empty tree
+	Arguments: ---
+	Output: ---
+	*/
+	void Build(void);
+	/*
+	Usage: Takes a node from the pool, growing it if needed
+	Arguments: ---
+	Output: index of the node
+	*/
+	int AllocateNode(void);
+	/*
+	Usage: Returns a node to the pool
+	Arguments: int a_nNode -> node to return
+	Output: ---
+	*/
+	void FreeNode(int a_nNode);
+	/*
+	Usage: Creates the leaf of an entity and inserts it in the tree
+	Arguments: uint a_uEntity -> index of the entity
+	Output: ---
+	*/
+	void InsertEntity(uint a_uEntity);
+	/*
+	Usage: Links a leaf in the tree next to the sibling with the lowest surface area cost
+	Arguments: int a_nLeaf -> leaf to insert
+	Output: ---
+	*/
+	void InsertLeaf(int a_nLeaf);
+	/*
+	Usage: Unlinks a leaf from the tree, the leaf node is kept
+	Arguments: int a_nLeaf -> leaf to remove
+	Output: ---
+	*/
+	void RemoveLeaf(int a_nLeaf);
+	/*
+	Usage: Recomputes the boxes from the given node up to the root
+	Arguments: int a_nNode -> first node to refit
+	Output: ---
+	*/
+	void Refit(int a_nNode);
+	/*
+	Usage: Adds the pairs between the entity and the leaves of the branch that overlap its leaf
+	Arguments:
+	-	int a_nNode -> branch to look into
+	-	int a_nLeaf -> leaf of the entity
+	-	std::vector<uint>& a_lPair -> list to add the pairs to
+	Output: ---
+	*/
+	void CollectPairs(int a_nNode, int a_nLeaf, std::vector<uint>& a_lPair);
+	/*
+	Usage: Surface area of the box, the cost of a node
+	Arguments:
+	-	vector3 a_v3Min -> minimum corner
+	-	vector3 a_v3Max -> maximum corner
+	Output: area
+	*/
+	static float SurfaceArea(vector3 a_v3Min, vector3 a_v3Max);
+};
+
+} //namespace Simplex
+
+#endif //__MYAABBTREE_H_
@@ -1,6 +1,6 @@
 #include "MyEntity.h"
 using namespace Simplex;
-std::map<String, MyEntity*> MyEntity::m_IDMap;
+std::map<String, MyEntity::MyPrototype> MyEntity::m_PrototypeMap;
 //  Accessors
 matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_m4ToWorld; }
 void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
@@ -8,6 +8,11 @@ void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 	if (!m_bInMemory)
 		return;
 
+	//the model composes the world matrices of its groups from this one, if it did not
+	//change there is nothing to push down (static and resting entities)
+	if (a_m4ToWorld == m_m4ToWorld)
+		return;
+
 	m_m4ToWorld = a_m4ToWorld;
 	m_pModel->SetModelMatrix(m_m4ToWorld);
 	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
@@ -24,16 +29,23 @@ void Simplex::MyEntity::Init(void)
 	m_bInMemory = false;
 	m_bSetAxis = false;
 	m_pModel = nullptr;
+	m_pPrototype = nullptr;
 	m_pRigidBody = nullptr;
 	m_DimensionArray = nullptr;
 	m_m4ToWorld = IDENTITY_M4;
 	m_sUniqueID = "";
 	m_nDimensionCount = 0;
+	m_uDimensionWords = 0;
+	m_uDimensionMask = nullptr;
+	m_uMaskFirst = 0;
+	m_uMaskEnd = 0;
+	m_bSparseDimensions = false;
 }
 void Simplex::MyEntity::Swap(MyEntity& other)
 {
 	m_bInMemory = false;
 	std::swap(m_pModel, other.m_pModel);
+	std::swap(m_pPrototype, other.m_pPrototype);
 	std::swap(m_pRigidBody, other.m_pRigidBody);
 	std::swap(m_m4ToWorld, other.m_m4ToWorld);
 	std::swap(m_pMeshMngr, other.m_pMeshMngr);
@@ -42,6 +54,11 @@ void Simplex::MyEntity::Swap(MyEntity& other)
 	std::swap(m_bSetAxis, other.m_bSetAxis);
 	std::swap(m_nDimensionCount, other.m_nDimensionCount);
 	std::swap(m_DimensionArray, other.m_DimensionArray);
+	std::swap(m_uDimensionWords, other.m_uDimensionWords);
+	std::swap(m_uDimensionMask, other.m_uDimensionMask);
+	std::swap(m_uMaskFirst, other.m_uMaskFirst);
+	std::swap(m_uMaskEnd, other.m_uMaskEnd);
+	std::swap(m_bSparseDimensions, other.m_bSparseDimensions);
 }
 void Simplex::MyEntity::Release(void)
 {
@@ -49,27 +66,34 @@ void Simplex::MyEntity::Release(void)
 	//it is not the job of the entity to release the model, 
 	//it is for the mesh manager to do so.
 	m_pModel = nullptr;
+	m_pPrototype = nullptr;
 	if (m_DimensionArray)
 	{
 		delete[] m_DimensionArray;
 		m_DimensionArray = nullptr;
 	}
+	if (m_uDimensionMask)
+	{
+		delete[] m_uDimensionMask;
+		m_uDimensionMask = nullptr;
+	}
+	m_uDimensionWords = 0;
 	SafeDelete(m_pRigidBody);
-	m_IDMap.erase(m_sUniqueID);
 }
 //The big 3
 Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
 {
 	Init();
-	m_pModel = new Model();
-	m_pModel->Load(a_sFileName);
+	m_pPrototype = GetPrototype(a_sFileName);
 	//if the model is loaded
-	if (m_pModel->GetName() != "")
+	if (m_pPrototype != nullptr)
 	{
-		GenUniqueID(a_sUniqueID);
 		m_sUniqueID = a_sUniqueID;
-		m_IDMap[a_sUniqueID] = this;
-		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); //generate a rigid body
+		//the instance shares the groups and meshes of the prototype, only its matrix is its own,
+		//named after the entity as that name is already unique
+		m_pModel = new Model();
+		m_pModel->Instance(m_pPrototype->m_pModel, a_sUniqueID);
+		m_pRigidBody = new MyRigidBody(*m_pPrototype->m_pRigidBody); //copy the precomputed bounds
 		m_bInMemory = true; //mark this entity as viable
 	}
 }
@@ -77,15 +101,35 @@ Simplex::MyEntity::MyEntity(MyEntity const& other)
 {
 	m_bInMemory = other.m_bInMemory;
 	m_pModel = other.m_pModel;
+	m_pPrototype = other.m_pPrototype;
 	//generate a new rigid body we do not share the same rigid body as we do the model
-	m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); 
+	if (m_pPrototype != nullptr)
+		m_pRigidBody = new MyRigidBody(*m_pPrototype->m_pRigidBody);
+	else
+		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList());
 	m_m4ToWorld = other.m_m4ToWorld;
+	m_pRigidBody->SetModelMatrix(m_m4ToWorld); //SetModelMatrix skips unchanged matrices, place it now
 	m_pMeshMngr = other.m_pMeshMngr;
 	m_sUniqueID = other.m_sUniqueID;
 	m_bSetAxis = other.m_bSetAxis;
 	m_nDimensionCount = other.m_nDimensionCount;
-	m_DimensionArray = other.m_DimensionArray;
-
+	m_bSparseDimensions = other.m_bSparseDimensions;
+	m_uMaskFirst = other.m_uMaskFirst;
+	m_uMaskEnd = other.m_uMaskEnd;
+	//the dimension storage is owned by each entity, copy it
+	m_DimensionArray = nullptr;
+	if (other.m_DimensionArray)
+	{
+		m_DimensionArray = new uint[m_nDimensionCount];
+		memcpy(m_DimensionArray, other.m_DimensionArray, sizeof(uint) * m_nDimensionCount);
+	}
+	m_uDimensionWords = other.m_uDimensionWords;
+	m_uDimensionMask = nullptr;
+	if (other.m_uDimensionMask)
+	{
+		m_uDimensionMask = new uint[m_uDimensionWords];
+		memcpy(m_uDimensionMask, other.m_uDimensionMask, sizeof(uint) * m_uDimensionWords);
+	}
 }
 MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
 {
@@ -99,6 +143,34 @@ MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
 	return *this;
 }
 MyEntity::~MyEntity(){Release();}
+//--- Prototypes
+MyEntity::MyPrototype* Simplex::MyEntity::GetPrototype(String a_sFileName)
+{
+	auto it = m_PrototypeMap.find(a_sFileName);
+	if (it != m_PrototypeMap.end())
+		return &it->second;
+
+	//first entity of this file, load the model and scan its vertices once
+	Model* pModel = new Model();
+	pModel->Load(a_sFileName);
+	if (pModel->GetName() == "")
+	{
+		SafeDelete(pModel);
+		return nullptr;
+	}
+
+	MyPrototype prototype;
+	prototype.m_pModel = pModel;
+	prototype.m_pRigidBody = new MyRigidBody(pModel->GetVertexList());
+	return &m_PrototypeMap.insert(std::make_pair(a_sFileName, prototype)).first->second;
+}
+void Simplex::MyEntity::ReleasePrototypes(void)
+{
+	//like the models of the entities, the prototype models are released by the mesh manager
+	for (auto it = m_PrototypeMap.begin(); it != m_PrototypeMap.end(); ++it)
+		SafeDelete(it->second.m_pRigidBody);
+	m_PrototypeMap.clear();
+}
 //--- Methods
 void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 {
@@ -116,26 +188,56 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 	if (m_bSetAxis)
 		m_pMeshMngr->AddAxisToRenderList(m_m4ToWorld);
 }
-MyEntity* Simplex::MyEntity::GetEntity(String a_sUniqueID)
+void Simplex::MyEntity::ReserveDimensions(uint a_uDimensionCount)
 {
-	//look the entity based on the unique id
-	auto entity = m_IDMap.find(a_sUniqueID);
-	//if not found return nullptr, if found return it
-	return entity == m_IDMap.end() ? nullptr : entity->second;
-}
-void Simplex::MyEntity::GenUniqueID(String& a_sUniqueID)
-{
-	static uint index = 0;
-	String sName = a_sUniqueID;
-	MyEntity* pEntity = GetEntity(a_sUniqueID);
-	//while MyEntity exists keep changing name
-	while (pEntity)
+	//keep the dimensions we already live in
+	std::vector<uint> lDimension;
+	if (m_bSparseDimensions)
 	{
-		a_sUniqueID = sName + "_" + std::to_string(index);
-		index++;
-		pEntity = GetEntity(a_sUniqueID);
+		lDimension.assign(m_DimensionArray, m_DimensionArray + m_nDimensionCount);
+	}
+	else
+	{
+		for (uint uWord = m_uMaskFirst; uWord < m_uMaskEnd; ++uWord)
+		{
+			for (uint uBit = 0; uBit < 32; ++uBit)
+			{
+				if (m_uDimensionMask[uWord] & (1u << uBit))
+					lDimension.push_back(uWord * 32 + uBit);
+			}
+		}
+	}
+
+	//release the old storage
+	if (m_DimensionArray)
+	{
+		delete[] m_DimensionArray;
+		m_DimensionArray = nullptr;
+	}
+	if (m_uDimensionMask)
+	{
+		delete[] m_uDimensionMask;
+		m_uDimensionMask = nullptr;
+	}
+	m_uDimensionWords = 0;
+	m_uMaskFirst = 0;
+	m_uMaskEnd = 0;
+	m_nDimensionCount = 0;
+
+	//too many dimensions for a mask per entity, use the sorted list
+	m_bSparseDimensions = a_uDimensionCount > m_uSparseDimensionLimit;
+	if (!m_bSparseDimensions && a_uDimensionCount > 0)
+	{
+		m_uDimensionWords = (a_uDimensionCount + 31) / 32;
+		m_uDimensionMask = new uint[m_uDimensionWords];
+		memset(m_uDimensionMask, 0, sizeof(uint) * m_uDimensionWords);
+	}
+
+	//add back the dimensions we had
+	for (uint i = 0; i < lDimension.size(); ++i)
+	{
+		AddDimension(lDimension[i]);
 	}
-	return;
 }
 void Simplex::MyEntity::AddDimension(uint a_uDimension)
 {
@@ -143,49 +245,90 @@ void Simplex::MyEntity::AddDimension(uint a_uDimension)
 	if (IsInDimension(a_uDimension))
 		return;//it is, so there is no need to add
 
-	//insert the entry
-	uint* pTemp;
-	pTemp = new uint[m_nDimensionCount + 1];
-	if(m_DimensionArray)
+	if (m_bSparseDimensions)
 	{
-		memcpy(pTemp, m_DimensionArray, sizeof(uint) * m_nDimensionCount);
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
+		//insert the entry keeping the list sorted
+		uint uPosition = static_cast<uint>(std::lower_bound(m_DimensionArray, m_DimensionArray + m_nDimensionCount, a_uDimension) - m_DimensionArray);
+		uint* pTemp;
+		pTemp = new uint[m_nDimensionCount + 1];
+		if (m_DimensionArray)
+		{
+			memcpy(pTemp, m_DimensionArray, sizeof(uint) * uPosition);
+			memcpy(pTemp + uPosition + 1, m_DimensionArray + uPosition, sizeof(uint) * (m_nDimensionCount - uPosition));
+			delete[] m_DimensionArray;
+			m_DimensionArray = nullptr;
+		}
+		pTemp[uPosition] = a_uDimension;
+		m_DimensionArray = pTemp;
+
+		++m_nDimensionCount;
+		return;
 	}
-	pTemp[m_nDimensionCount] = a_uDimension;
-	m_DimensionArray = pTemp;
 
-	++m_nDimensionCount;
+	//grow the mask if the dimension does not fit (the octree was not reserved for)
+	uint uWord = a_uDimension / 32;
+	if (uWord >= m_uDimensionWords)
+	{
+		uint uWords = glm::max(uWord + 1, m_uDimensionWords * 2);
+		uint* pTemp;
+		pTemp = new uint[uWords];
+		memset(pTemp, 0, sizeof(uint) * uWords);
+		if (m_uDimensionMask)
+		{
+			memcpy(pTemp, m_uDimensionMask, sizeof(uint) * m_uDimensionWords);
+			delete[] m_uDimensionMask;
+			m_uDimensionMask = nullptr;
+		}
+		m_uDimensionMask = pTemp;
+		m_uDimensionWords = uWords;
+	}
+
+	//set the bit and widen the range of words in use
+	m_uDimensionMask[uWord] |= 1u << (a_uDimension % 32);
+	if (m_nDimensionCount == 0)
+	{
+		m_uMaskFirst = uWord;
+		m_uMaskEnd = uWord + 1;
+	}
+	else
+	{
+		m_uMaskFirst = glm::min(m_uMaskFirst, uWord);
+		m_uMaskEnd = glm::max(m_uMaskEnd, uWord + 1);
+	}
 
-	SortDimensions();
+	++m_nDimensionCount;
 }
 void Simplex::MyEntity::RemoveDimension(uint a_uDimension)
 {
-	//if there are no dimensions return
-	if (m_nDimensionCount == 0)
+	//if we are not in that dimension return
+	if (!IsInDimension(a_uDimension))
 		return;
 
-	//we look one by one if its the one wanted
-	for (uint i = 0; i < m_nDimensionCount; i++)
+	if (m_bSparseDimensions)
 	{
-		if (m_DimensionArray[i] == a_uDimension)
+		//pop the entry keeping the list sorted
+		uint uPosition = static_cast<uint>(std::lower_bound(m_DimensionArray, m_DimensionArray + m_nDimensionCount, a_uDimension) - m_DimensionArray);
+		uint* pTemp = nullptr;
+		if (m_nDimensionCount > 1)
 		{
-			//if it is, then we swap it with the last one and then we pop
-			std::swap(m_DimensionArray[i], m_DimensionArray[m_nDimensionCount - 1]);
-			uint* pTemp;
 			pTemp = new uint[m_nDimensionCount - 1];
-			if (m_DimensionArray)
-			{
-				memcpy(pTemp, m_DimensionArray, sizeof(uint) * (m_nDimensionCount-1));
-				delete[] m_DimensionArray;
-				m_DimensionArray = nullptr;
-			}
-			m_DimensionArray = pTemp;
-			
-			--m_nDimensionCount;
-			SortDimensions();
-			return;
+			memcpy(pTemp, m_DimensionArray, sizeof(uint) * uPosition);
+			memcpy(pTemp + uPosition, m_DimensionArray + uPosition + 1, sizeof(uint) * (m_nDimensionCount - uPosition - 1));
 		}
+		delete[] m_DimensionArray;
+		m_DimensionArray = pTemp;
+
+		--m_nDimensionCount;
+		return;
+	}
+
+	//clear the bit, the range of words stays conservative
+	m_uDimensionMask[a_uDimension / 32] &= ~(1u << (a_uDimension % 32));
+	--m_nDimensionCount;
+	if (m_nDimensionCount == 0)
+	{
+		m_uMaskFirst = 0;
+		m_uMaskEnd = 0;
 	}
 }
 void Simplex::MyEntity::ClearDimensionSet(void)
@@ -195,17 +338,25 @@ void Simplex::MyEntity::ClearDimensionSet(void)
 		delete[] m_DimensionArray;
 		m_DimensionArray = nullptr;
 	}
+	//keep the mask allocated, the octree is going to fill it again
+	if (m_uDimensionMask && m_uMaskEnd > m_uMaskFirst)
+	{
+		memset(m_uDimensionMask + m_uMaskFirst, 0, sizeof(uint) * (m_uMaskEnd - m_uMaskFirst));
+	}
+	m_uMaskFirst = 0;
+	m_uMaskEnd = 0;
 	m_nDimensionCount = 0;
 }
 bool Simplex::MyEntity::IsInDimension(uint a_uDimension)
 {
 	//see if the entry is in the set
-	for (uint i = 0; i < m_nDimensionCount; i++)
-	{
-		if (m_DimensionArray[i] == a_uDimension)
-			return true;
-	}
-	return false;
+	if (m_bSparseDimensions)
+		return std::binary_search(m_DimensionArray, m_DimensionArray + m_nDimensionCount, a_uDimension);
+
+	uint uWord = a_uDimension / 32;
+	if (uWord >= m_uDimensionWords)
+		return false;
+	return (m_uDimensionMask[uWord] & (1u << (a_uDimension % 32))) != 0;
 }
 bool Simplex::MyEntity::SharesDimension(MyEntity* const a_pOther)
 {
@@ -220,14 +371,47 @@ bool Simplex::MyEntity::SharesDimension(MyEntity* const a_pOther)
 			return true;
 	}
 
-	//for each dimension on both Entities we check if there is a common dimension
-	for (uint i = 0; i < m_nDimensionCount; ++i)
+	//if either one is not in any dimension there is nothing to share
+	if (0 == m_nDimensionCount || 0 == a_pOther->m_nDimensionCount)
+		return false;
+
+	//both masks: AND the words both entities may have bits in
+	if (!m_bSparseDimensions && !a_pOther->m_bSparseDimensions)
 	{
-		for (uint j = 0; j < a_pOther->m_nDimensionCount; j++)
+		uint uFirst = glm::max(m_uMaskFirst, a_pOther->m_uMaskFirst);
+		uint uEnd = glm::min(m_uMaskEnd, a_pOther->m_uMaskEnd);
+		for (uint uWord = uFirst; uWord < uEnd; ++uWord)
 		{
-			if (m_DimensionArray[i] == a_pOther->m_DimensionArray[j])
+			if (m_uDimensionMask[uWord] & a_pOther->m_uDimensionMask[uWord])
 				return true; //as soon as we find one we know they share dimensionality
 		}
+		return false;
+	}
+
+	//one list and one mask: test each entry of the list against the mask
+	if (!m_bSparseDimensions || !a_pOther->m_bSparseDimensions)
+	{
+		MyEntity* pList = m_bSparseDimensions ? this : a_pOther;
+		MyEntity* pMask = m_bSparseDimensions ? a_pOther : this;
+		for (uint i = 0; i < pList->m_nDimensionCount; ++i)
+		{
+			if (pMask->IsInDimension(pList->m_DimensionArray[i]))
+				return true;
+		}
+		return false;
+	}
+
+	//both lists: they are sorted so we walk them at the same time
+	uint i = 0;
+	uint j = 0;
+	while (i < m_nDimensionCount && j < a_pOther->m_nDimensionCount)
+	{
+		if (m_DimensionArray[i] == a_pOther->m_DimensionArray[j])
+			return true; //as soon as we find one we know they share dimensionality
+		if (m_DimensionArray[i] < a_pOther->m_DimensionArray[j])
+			++i;
+		else
+			++j;
 	}
 
 	//could not find a common dimension
@@ -252,5 +436,6 @@ void Simplex::MyEntity::ClearCollisionList(void)
 }
 void Simplex::MyEntity::SortDimensions(void)
 {
-	std::sort(m_DimensionArray, m_DimensionArray + m_nDimensionCount);
+	if (m_bSparseDimensions)
+		std::sort(m_DimensionArray, m_DimensionArray + m_nDimensionCount);
 }
\ No newline at end of file
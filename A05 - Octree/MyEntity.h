@@ -13,27 +13,40 @@ namespace Simplex
 //System Class
 class MyEntity
 {
+	//Model and local bounds loaded from a file, shared by every entity spawned from it
+	struct MyPrototype
+	{
+		Model* m_pModel = nullptr; //loaded model, its instances share its groups and meshes
+		MyRigidBody* m_pRigidBody = nullptr; //rigid body holding the local bounds of the model
+	};
+	static std::map<String, MyPrototype> m_PrototypeMap; //prototypes by file name
+
 	bool m_bInMemory = false; //loaded flag
 	bool m_bSetAxis = false; //render axis flag
 	String m_sUniqueID = ""; //Unique identifier name
 
 	uint m_nDimensionCount = 0; //tells how many dimensions this entity lives in
-	uint* m_DimensionArray = nullptr; //Dimensions on which this entity is located
+	uint* m_DimensionArray = nullptr; //sorted dimensions on which this entity is located (sparse storage only)
+	uint m_uDimensionWords = 0; //number of 32 bit words allocated for the dimension mask
+	uint* m_uDimensionMask = nullptr; //one bit per dimension on which this entity is located (dense storage only)
+	uint m_uMaskFirst = 0; //first word of the mask that may have a bit set
+	uint m_uMaskEnd = 0; //one past the last word of the mask that may have a bit set
+	bool m_bSparseDimensions = false; //are the dimensions stored as a sorted list instead of a mask?
+	static const uint m_uSparseDimensionLimit = 2048; //dimension count above which the sorted list is used
 
 	Model* m_pModel = nullptr; //Model associated with this MyEntity
+	MyPrototype* m_pPrototype = nullptr; //prototype this MyEntity was spawned from
 	MyRigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this MyEntity
 
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this MyEntity
 	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
 
-	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
-
 public:
 	/*
 	Usage: Constructor that specifies the name attached to the MyEntity
 	Arguments:
 	-	String a_sFileName -> Name of the model to load
-	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	-	String a_sUniqueID -> Name wanted as identifier, the entity manager makes sure it is unique
 	Output: class object instance
 	*/
 	MyEntity(String a_sFileName, String a_sUniqueID = "NA");
@@ -104,18 +117,6 @@ public:
 	*/
 	bool IsColliding(MyEntity* const other);
 	/*
-	USAGE: Gets the MyEntity specified by unique ID, nullptr if not exists
-	ARGUMENTS: String a_sUniqueID -> unique ID if the queried entity
-	OUTPUT: MyEntity specified by unique ID, nullptr if not exists
-	*/
-	static MyEntity* GetEntity(String a_sUniqueID);
-	/*
-	USAGE: Will generate a unique id based on the name provided
-	ARGUMENTS: String& a_sUniqueID -> desired name
-	OUTPUT: will output though the argument
-	*/
-	void GenUniqueID(String& a_sUniqueID);
-	/*
 	USAGE: Gets the Unique ID name of this model
 	ARGUMENTS: ---
 	OUTPUT: ---
@@ -128,6 +129,14 @@ public:
 	*/
 	void SetAxisVisible(bool a_bSetAxis = true);
 	/*
+	USAGE: Sizes the dimension storage for the specified number of dimensions, a bit mask
+		with one bit per dimension or, if there are too many to keep a mask per entity,
+		a sorted list of dimensions
+	ARGUMENTS: uint a_uDimensionCount -> number of dimensions (octants) in the space
+	OUTPUT: ---
+	*/
+	void ReserveDimensions(uint a_uDimensionCount);
+	/*
 	USAGE: Will set a dimension to the MyEntity
 	ARGUMENTS: uint a_uDimension -> dimension to set
 	OUTPUT: ---
@@ -166,11 +175,17 @@ public:
 	void ClearCollisionList(void);
 
 	/*
-	USAGE: Will sort the array of dimensions
+	USAGE: Will sort the array of dimensions, the mask is always in order
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void SortDimensions(void);
+	/*
+	USAGE: Releases the models and bounds loaded for spawning, call once no entity is left
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	static void ReleasePrototypes(void);
 
 private:
 	/*
@@ -185,6 +200,12 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: Gets the prototype of a file, loading the model and computing its bounds the first time
+	Arguments: String a_sFileName -> name of the model
+	Output: prototype, nullptr if the model could not be loaded
+	*/
+	static MyPrototype* GetPrototype(String a_sFileName);
 };//class
 
   //EXPIMP_TEMPLATE template class SimplexDLL std::vector<MyEntity>;
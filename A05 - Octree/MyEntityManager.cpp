@@ -6,6 +6,9 @@ void Simplex::MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
 	m_mEntityArray = nullptr;
+	m_IDIndexMap.clear();
+	m_PairList.clear();
+	m_bPairList = false;
 }
 void Simplex::MyEntityManager::Release(void)
 {
@@ -15,7 +18,14 @@ void Simplex::MyEntityManager::Release(void)
 		SafeDelete(pEntity);
 	}
 	m_uEntityCount = 0;
-	m_mEntityArray = nullptr;
+	if (m_mEntityArray)
+	{
+		delete[] m_mEntityArray;
+		m_mEntityArray = nullptr;
+	}
+	m_IDIndexMap.clear();
+	ClearPairList();
+	MyEntity::ReleasePrototypes();
 }
 Simplex::MyEntityManager* Simplex::MyEntityManager::GetInstance()
 {
@@ -35,14 +45,31 @@ void Simplex::MyEntityManager::ReleaseInstance()
 }
 int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 {
-	//look one by one for the specified unique id
-	for (uint uIndex = 0; uIndex < m_uEntityCount; ++uIndex)
+	//look for the unique id in the hash index
+	auto entry = m_IDIndexMap.find(a_sUniqueID);
+	//if not found return -1
+	if (entry == m_IDIndexMap.end())
+		return -1;
+	return entry->second;
+}
+Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(String a_sUniqueID)
+{
+	int nIndex = GetEntityIndex(a_sUniqueID);
+	//if not found return nullptr
+	if (nIndex < 0)
+		return nullptr;
+	return m_mEntityArray[nIndex];
+}
+void Simplex::MyEntityManager::GenUniqueID(String& a_sUniqueID)
+{
+	static uint index = 0;
+	String sName = a_sUniqueID;
+	//while the name is taken keep changing it
+	while (m_IDIndexMap.find(a_sUniqueID) != m_IDIndexMap.end())
 	{
-		if (a_sUniqueID == m_mEntityArray[uIndex]->GetUniqueID())
-			return uIndex;
+		a_sUniqueID = sName + "_" + std::to_string(index);
+		index++;
 	}
-	//if not found return -1
-	return -1;
 }
 //Accessors
 Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_uEntityCount; }
@@ -61,7 +88,7 @@ Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 Simplex::Model* Simplex::MyEntityManager::GetModel(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -84,7 +111,7 @@ Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(uint a_uIndex)
 Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -107,7 +134,7 @@ Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(uint a_uIndex)
 Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -118,7 +145,7 @@ Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -140,7 +167,7 @@ void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uInd
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -173,8 +200,18 @@ void Simplex::MyEntityManager::Update(void)
 		m_mEntityArray[i]->ClearCollisionList();
 	}
 
+	//check collisions only on the pairs that share an octant
+	if (m_bPairList)
+	{
+		for (uint uPair = 0; uPair < m_PairList.size(); uPair += 2)
+		{
+			m_mEntityArray[m_PairList[uPair]]->IsColliding(m_mEntityArray[m_PairList[uPair + 1]]);
+		}
+		return;
+	}
+
 	//check collisions
-	for (uint i = 0; i < m_uEntityCount - 1; i++)
+	for (uint i = 0; i + 1 < m_uEntityCount; i++)
 	{
 		for (uint j = i + 1; j < m_uEntityCount; j++)
 		{
@@ -182,8 +219,26 @@ void Simplex::MyEntityManager::Update(void)
 		}
 	}
 }
+void Simplex::MyEntityManager::SetPairList(std::vector<uint> const& a_PairList)
+{
+	m_PairList = a_PairList;
+	m_bPairList = true;
+}
+uint Simplex::MyEntityManager::GetPairCount(void)
+{
+	if (m_bPairList)
+		return static_cast<uint>(m_PairList.size() / 2);
+	return m_uEntityCount * (m_uEntityCount - 1) / 2;
+}
+void Simplex::MyEntityManager::ClearPairList(void)
+{
+	m_PairList.clear();
+	m_bPairList = false;
+}
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
+	//make sure the identifier is not taken
+	GenUniqueID(a_sUniqueID);
 	//Create a temporal entity to store the object
 	MyEntity* pTemp = new MyEntity(a_sFileName, a_sUniqueID);
 	//if I was able to generate it add it to the list
@@ -206,9 +261,17 @@ void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 		}
 		//make the member pointer the temp pointer
 		m_mEntityArray = tempArray;
+		//index the new entity by its unique id
+		m_IDIndexMap[pTemp->GetUniqueID()] = m_uEntityCount;
+		//the octree does not know about this one, test all pairs until it is rebuilt
+		ClearPairList();
 		//add one entity to the count
 		++m_uEntityCount;
 	}
+	else
+	{
+		SafeDelete(pTemp);
+	}
 }
 void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 {
@@ -220,13 +283,22 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//the removed entity leaves the index
+	m_IDIndexMap.erase(m_mEntityArray[a_uIndex]->GetUniqueID());
+	//the candidate pairs refer to the old indices
+	ClearPairList();
+
 	// if the entity is not the very last we swap it for the last one
 	if (a_uIndex != m_uEntityCount - 1)
 	{
 		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[m_uEntityCount - 1]);
+		//the last one moved, keep the index in step
+		m_IDIndexMap[m_mEntityArray[a_uIndex]->GetUniqueID()] = a_uIndex;
 	}
 	
 	//and then pop the last one
+	MyEntity* pEntity = m_mEntityArray[m_uEntityCount - 1];
+	SafeDelete(pEntity);
 	//create a new temp array with one less entry
 	PEntity* tempArray = new PEntity[m_uEntityCount - 1];
 	//start from 0 to the current count
@@ -247,6 +319,9 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 void Simplex::MyEntityManager::RemoveEntity(String a_sUniqueID)
 {
 	int nIndex = GetEntityIndex(a_sUniqueID);
+	//if not found there is nothing to remove (-1 would remove the last one)
+	if (nIndex < 0)
+		return;
 	RemoveEntity((uint)nIndex);
 }
 Simplex::String Simplex::MyEntityManager::GetUniqueID(uint a_uIndex)
@@ -292,7 +367,7 @@ void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigi
 void Simplex::MyEntityManager::AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -314,7 +389,7 @@ void Simplex::MyEntityManager::AddDimension(uint a_uIndex, uint a_uDimension)
 void Simplex::MyEntityManager::AddDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -336,13 +411,20 @@ void Simplex::MyEntityManager::RemoveDimension(uint a_uIndex, uint a_uDimension)
 void Simplex::MyEntityManager::RemoveDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
 		pTemp->RemoveDimension(a_uDimension);
 	}
 }
+void Simplex::MyEntityManager::ReserveDimensions(uint a_uDimensionCount)
+{
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		m_mEntityArray[i]->ReserveDimensions(a_uDimensionCount);
+	}
+}
 void Simplex::MyEntityManager::ClearDimensionSetAll(void)
 {
 	for (uint i = 0; i < m_uEntityCount; ++i)
@@ -365,7 +447,7 @@ void Simplex::MyEntityManager::ClearDimensionSet(uint a_uIndex)
 void Simplex::MyEntityManager::ClearDimensionSet(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -387,7 +469,7 @@ bool Simplex::MyEntityManager::IsInDimension(uint a_uIndex, uint a_uDimension)
 bool Simplex::MyEntityManager::IsInDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
@@ -410,7 +492,7 @@ bool Simplex::MyEntityManager::SharesDimension(uint a_uIndex, MyEntity* const a_
 bool Simplex::MyEntityManager::SharesDimension(String a_sUniqueID, MyEntity* const a_pOther)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(a_sUniqueID);
 	//if the entity exists
 	if (pTemp)
 	{
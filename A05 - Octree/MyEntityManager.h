@@ -6,6 +6,7 @@ Date: 2017/07
 #define __MYENTITYMANAGER_H_
 
 #include "MyEntity.h"
+#include <unordered_map>
 
 namespace Simplex
 {
@@ -16,6 +17,9 @@ class MyEntityManager
 	typedef MyEntity* PEntity; //MyEntity Pointer
 	uint m_uEntityCount = 0; //number of elements in the list
 	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
+	std::unordered_map<String, uint> m_IDIndexMap; //unique ID to index in the entity array, the only index of IDs
+	std::vector<uint> m_PairList; //candidate pairs of entity indices (two entries per pair) given by the octree
+	bool m_bPairList = false; //use the candidate pairs instead of testing all pairs?
 	static MyEntityManager* m_pInstance; // Singleton pointer
 public:
 	/*
@@ -37,6 +41,12 @@ public:
 	*/
 	int GetEntityIndex(String a_sUniqueID);
 	/*
+	USAGE: Gets the entity specified by unique ID
+	ARGUMENTS: String a_sUniqueID -> unique ID of the queried entity
+	OUTPUT: MyEntity specified by unique ID, nullptr if not exists
+	*/
+	MyEntity* GetEntity(String a_sUniqueID);
+	/*
 	USAGE: Will add an entity to the list
 	ARGUMENTS:
 	-	String a_sFileName -> Name of the model to load
@@ -191,6 +201,31 @@ public:
 	*/
 	void RemoveDimension(String a_sUniqueID, uint a_uDimension);
 	/*
+	USAGE: will size the dimension storage of all entities for the number of dimensions
+	ARGUMENTS: uint a_uDimensionCount -> number of dimensions (octants) in the space
+	OUTPUT: ---
+	*/
+	void ReserveDimensions(uint a_uDimensionCount);
+	/*
+	USAGE: Sets the list of candidate pairs that Update will test, instead of testing all pairs
+	ARGUMENTS: std::vector<uint> const& a_PairList -> indices of the entities in each pair, two entries
+		per pair, lower index first and without repeated pairs
+	OUTPUT: ---
+	*/
+	void SetPairList(std::vector<uint> const& a_PairList);
+	/*
+	USAGE: Gets the number of pairs Update will test
+	ARGUMENTS: ---
+	OUTPUT: candidate pairs, or all the pairs if there is no list
+	*/
+	uint GetPairCount(void);
+	/*
+	USAGE: Drops the list of candidate pairs, Update will test all pairs
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ClearPairList(void);
+	/*
 	USAGE: will remove all dimensions from all entities
 	ARGUMENTS: ---
 	OUTPUT: ---
@@ -283,6 +318,12 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: Will generate a unique id based on the name provided
+	Arguments: String& a_sUniqueID -> desired name
+	Output: will output though the argument
+	*/
+	void GenUniqueID(String& a_sUniqueID);
 };//class
 
 } //namespace Simplex
@@ -4,6 +4,7 @@ using namespace Simplex;
 uint MyOctant::m_uOctantCount = 0;
 uint MyOctant::m_uMaxLevel = 3;
 uint MyOctant::m_uIdealEntityCount = 5;
+float MyOctant::m_fLooseness = 1.0f;
 
 //Initializes octree
 void MyOctant::Init(void) {
@@ -99,6 +100,43 @@ uint MyOctant::GetOctantCount(void)
 	return m_uOctantCount; 
 }
 
+//Node Count Getter
+uint MyOctant::GetNodeCount(void)
+{
+	return m_uOctantCount;
+}
+
+//Name Getter
+String MyOctant::GetName(void)
+{
+	if (m_fLooseness > 1.0f)
+		return "Loose Octree";
+	return "Octree";
+}
+
+//Loose Min Getter
+vector3 MyOctant::GetLooseMin(void)
+{
+	return m_v3Center - vector3(m_fSize * m_fLooseness / 2.0f);
+}
+
+//Loose Max Getter
+vector3 MyOctant::GetLooseMax(void)
+{
+	return m_v3Center + vector3(m_fSize * m_fLooseness / 2.0f);
+}
+
+//rebuilds the tree for the current position of the entities
+void MyOctant::Update(void)
+{
+	//if it aint the root
+	if (m_uLevel != 0)
+		return;
+
+	m_pEntityMngr->ClearDimensionSetAll();
+	ConstructTree(m_uMaxLevel);
+}
+
 //determines if there is a collision
 bool MyOctant::IsColliding(uint a_uRBIndex)
 {
@@ -314,17 +352,34 @@ void MyOctant::ConstructTree(u_int a_nMaxLevel)
 		Subdivide();
 	}
 
+	//size the dimension masks of the entities for the octants we have
+	m_pEntityMngr->ReserveDimensions(m_uOctantCount);
+
 	//create individualized IDs
 	AssignIDtoEntity();
 
 	//create the tree!
 	ConstructList();
 
+	//only the entities sharing a leaf need to be tested against each other
+	ConstructPairList();
 }
 
 //Individualized ID assignment
 void MyOctant::AssignIDtoEntity(void)
 {
+	//loose octree, the root places every entity in a single octant
+	if (m_fLooseness > 1.0f) {
+		if (m_uLevel != 0)
+			return;
+
+		uint nEntities = m_pEntityMngr->GetEntityCount();
+		for (uint i = 0; i < nEntities; i++) {
+			AssignLoose(i);
+		}
+		return;
+	}
+
 	//recursive assignment of IDs to children
 	for (int i = 0; i < m_uChildren; i++) {
 		m_pChild[i]->AssignIDtoEntity();
@@ -343,16 +398,309 @@ void MyOctant::AssignIDtoEntity(void)
 	}
 }
 
+//Loose placement
+void MyOctant::AssignLoose(uint a_uRBIndex)
+{
+	MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(a_uRBIndex)->GetRigidBody();
+	vector3 v3MinG = pRigidBody->GetMinGlobal();
+	vector3 v3MaxG = pRigidBody->GetMaxGlobal();
+	vector3 v3Center = (v3MinG + v3MaxG) / 2.0f;
+
+	//go down into the child that has our center if its loose bounds can hold us
+	for (int i = 0; i < m_uChildren; i++) {
+		MyOctant* pChild = m_pChild[i];
+		if (glm::any(glm::lessThan(v3Center, pChild->m_v3Min)) || glm::any(glm::greaterThan(v3Center, pChild->m_v3Max)))
+			continue;
+		if (glm::all(glm::greaterThanEqual(v3MinG, pChild->GetLooseMin())) && glm::all(glm::lessThanEqual(v3MaxG, pChild->GetLooseMax()))) {
+			pChild->AssignLoose(a_uRBIndex);
+			return;
+		}
+		break;
+	}
+
+	//no child can hold it, it stays here
+	m_EntityList.push_back(a_uRBIndex);
+}
+
+//Loose pair gathering
+void MyOctant::CollectLoosePairs(MyOctant* a_pOctant, std::vector<uint>& a_lPair)
+{
+	//the loose bounds of the children are inside ours, if we do not overlap neither do they
+	vector3 v3Min = a_pOctant->GetLooseMin();
+	vector3 v3Max = a_pOctant->GetLooseMax();
+	if (glm::any(glm::lessThan(GetLooseMax(), v3Min)) || glm::any(glm::greaterThan(GetLooseMin(), v3Max)))
+		return;
+
+	std::vector<uint>& lOther = a_pOctant->m_EntityList;
+	if (m_uID == a_pOctant->m_uID) {
+		//pairs inside the octant
+		for (uint i = 0; i + 1 < m_EntityList.size(); i++) {
+			for (uint j = i + 1; j < m_EntityList.size(); j++) {
+				a_lPair.push_back(glm::min(m_EntityList[i], m_EntityList[j]));
+				a_lPair.push_back(glm::max(m_EntityList[i], m_EntityList[j]));
+			}
+		}
+	}
+	else if (m_uID > a_pOctant->m_uID) {
+		//pairs between octants, only from the lower ID so each one is found once
+		for (uint i = 0; i < m_EntityList.size(); i++) {
+			for (uint j = 0; j < lOther.size(); j++) {
+				a_lPair.push_back(glm::min(m_EntityList[i], lOther[j]));
+				a_lPair.push_back(glm::max(m_EntityList[i], lOther[j]));
+			}
+		}
+	}
+
+	for (int i = 0; i < m_uChildren; i++) {
+		m_pChild[i]->CollectLoosePairs(a_pOctant, a_lPair);
+	}
+}
+
+//Candidate pair generation
+void MyOctant::ConstructPairList(void)
+{
+	//if it aint the root
+	if (m_uLevel != 0)
+		return;
+
+	//a single octant holds everything, testing all pairs is the same work
+	if (m_uChildren == 0) {
+		m_pEntityMngr->ClearPairList();
+		return;
+	}
+
+	//loose octree, every entity is in one octant so the pairs come out unique
+	if (m_fLooseness > 1.0f) {
+		std::vector<uint> lPair;
+		for (uint uOctant = 0; uOctant < m_lChild.size(); uOctant++) {
+			CollectLoosePairs(m_lChild[uOctant], lPair);
+		}
+		m_pEntityMngr->SetPairList(lPair);
+		return;
+	}
+
+	//every pair of entities in each leaf, packed as lower index in the high half
+	std::vector<uint64_t> lKey;
+	for (uint uLeaf = 0; uLeaf < m_lChild.size(); uLeaf++) {
+		std::vector<uint>& lEntity = m_lChild[uLeaf]->m_EntityList;
+		for (uint i = 0; i + 1 < lEntity.size(); i++) {
+			for (uint j = i + 1; j < lEntity.size(); j++) {
+				uint uA = glm::min(lEntity[i], lEntity[j]);
+				uint uB = glm::max(lEntity[i], lEntity[j]);
+				lKey.push_back((static_cast<uint64_t>(uA) << 32) | uB);
+			}
+		}
+	}
+
+	//entities straddling several leaves show up once per leaf they share
+	std::sort(lKey.begin(), lKey.end());
+	lKey.erase(std::unique(lKey.begin(), lKey.end()), lKey.end());
+
+	std::vector<uint> lPair;
+	lPair.reserve(lKey.size() * 2);
+	for (uint i = 0; i < lKey.size(); i++) {
+		lPair.push_back(static_cast<uint>(lKey[i] >> 32));
+		lPair.push_back(static_cast<uint>(lKey[i]));
+	}
+	m_pEntityMngr->SetPairList(lPair);
+}
+
+//Ray cast, octants are visited in the order the ray enters them
+int MyOctant::RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance)
+{
+	vector3 v3Inverse = 1.0f / glm::normalize(a_v3Direction);
+	int nHit = -1;
+	float fClosest = FLT_MAX;
+	float fDistance = 0.0f;
+
+	//min heap of octants by the distance where the ray enters them
+	typedef std::pair<float, MyOctant*> OctantHit;
+	std::vector<OctantHit> lHeap;
+	if (RayHitsBox(a_v3Origin, v3Inverse, GetLooseMin(), GetLooseMax(), fClosest, fDistance))
+		lHeap.push_back(OctantHit(fDistance, this));
+
+	while (!lHeap.empty()) {
+		std::pop_heap(lHeap.begin(), lHeap.end(), std::greater<OctantHit>());
+		OctantHit next = lHeap.back();
+		lHeap.pop_back();
+
+		//every octant left starts behind the closest hit
+		if (next.first > fClosest)
+			break;
+
+		MyOctant* pOctant = next.second;
+		for (uint i = 0; i < pOctant->m_EntityList.size(); i++) {
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(pOctant->m_EntityList[i])->GetRigidBody();
+			if (RayHitsBox(a_v3Origin, v3Inverse, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal(), fClosest, fDistance) && fDistance < fClosest) {
+				fClosest = fDistance;
+				nHit = pOctant->m_EntityList[i];
+			}
+		}
+
+		for (int i = 0; i < pOctant->m_uChildren; i++) {
+			MyOctant* pChild = pOctant->m_pChild[i];
+			if (RayHitsBox(a_v3Origin, v3Inverse, pChild->GetLooseMin(), pChild->GetLooseMax(), fClosest, fDistance)) {
+				lHeap.push_back(OctantHit(fDistance, pChild));
+				std::push_heap(lHeap.begin(), lHeap.end(), std::greater<OctantHit>());
+			}
+		}
+	}
+
+	if (nHit != -1)
+		a_fDistance = fClosest;
+	return nHit;
+}
+
+//Ray cast that keeps every hit
+std::vector<uint> MyOctant::RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction)
+{
+	vector3 v3Inverse = 1.0f / glm::normalize(a_v3Direction);
+	float fDistance = 0.0f;
+	std::vector<std::pair<float, uint>> lHit;
+
+	std::vector<MyOctant*> lStack;
+	lStack.push_back(this);
+	while (!lStack.empty()) {
+		MyOctant* pOctant = lStack.back();
+		lStack.pop_back();
+		if (!RayHitsBox(a_v3Origin, v3Inverse, pOctant->GetLooseMin(), pOctant->GetLooseMax(), FLT_MAX, fDistance))
+			continue;
+
+		for (uint i = 0; i < pOctant->m_EntityList.size(); i++) {
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(pOctant->m_EntityList[i])->GetRigidBody();
+			if (RayHitsBox(a_v3Origin, v3Inverse, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal(), FLT_MAX, fDistance))
+				lHit.push_back(std::make_pair(fDistance, pOctant->m_EntityList[i]));
+		}
+		for (int i = 0; i < pOctant->m_uChildren; i++) {
+			lStack.push_back(pOctant->m_pChild[i]);
+		}
+	}
+
+	//an entity in several leaves is hit at the same distance each time
+	std::sort(lHit.begin(), lHit.end());
+	lHit.erase(std::unique(lHit.begin(), lHit.end()), lHit.end());
+
+	std::vector<uint> lEntity;
+	for (uint i = 0; i < lHit.size(); i++) {
+		lEntity.push_back(lHit[i].second);
+	}
+	return lEntity;
+}
+
+//Box query
+std::vector<uint> MyOctant::QueryAABB(vector3 a_v3Min, vector3 a_v3Max)
+{
+	std::vector<uint> lEntity;
+	std::vector<MyOctant*> lStack;
+	lStack.push_back(this);
+	while (!lStack.empty()) {
+		MyOctant* pOctant = lStack.back();
+		lStack.pop_back();
+		if (glm::any(glm::lessThan(pOctant->GetLooseMax(), a_v3Min)) || glm::any(glm::greaterThan(pOctant->GetLooseMin(), a_v3Max)))
+			continue;
+
+		for (uint i = 0; i < pOctant->m_EntityList.size(); i++) {
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(pOctant->m_EntityList[i])->GetRigidBody();
+			if (glm::all(glm::lessThanEqual(pRigidBody->GetMinGlobal(), a_v3Max)) && glm::all(glm::greaterThanEqual(pRigidBody->GetMaxGlobal(), a_v3Min)))
+				lEntity.push_back(pOctant->m_EntityList[i]);
+		}
+		for (int i = 0; i < pOctant->m_uChildren; i++) {
+			lStack.push_back(pOctant->m_pChild[i]);
+		}
+	}
+
+	std::sort(lEntity.begin(), lEntity.end());
+	lEntity.erase(std::unique(lEntity.begin(), lEntity.end()), lEntity.end());
+	return lEntity;
+}
+
+//Sphere query
+std::vector<uint> MyOctant::QuerySphere(vector3 a_v3Center, float a_fRadius)
+{
+	float fRadius2 = a_fRadius * a_fRadius;
+	std::vector<uint> lEntity;
+	std::vector<MyOctant*> lStack;
+	lStack.push_back(this);
+	while (!lStack.empty()) {
+		MyOctant* pOctant = lStack.back();
+		lStack.pop_back();
+		if (DistanceToBox2(a_v3Center, pOctant->GetLooseMin(), pOctant->GetLooseMax()) > fRadius2)
+			continue;
+
+		for (uint i = 0; i < pOctant->m_EntityList.size(); i++) {
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(pOctant->m_EntityList[i])->GetRigidBody();
+			if (DistanceToBox2(a_v3Center, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal()) <= fRadius2)
+				lEntity.push_back(pOctant->m_EntityList[i]);
+		}
+		for (int i = 0; i < pOctant->m_uChildren; i++) {
+			lStack.push_back(pOctant->m_pChild[i]);
+		}
+	}
+
+	std::sort(lEntity.begin(), lEntity.end());
+	lEntity.erase(std::unique(lEntity.begin(), lEntity.end()), lEntity.end());
+	return lEntity;
+}
+
+//K nearest, octants are visited closest first until they are farther than the k-th entity
+std::vector<uint> MyOctant::QueryNearest(vector3 a_v3Point, uint a_uCount)
+{
+	typedef std::pair<float, MyOctant*> OctantDistance;
+	std::vector<std::pair<float, uint>> lBest; //sorted closest first, at most a_uCount
+	std::vector<OctantDistance> lHeap;
+	if (a_uCount > 0)
+		lHeap.push_back(OctantDistance(DistanceToBox2(a_v3Point, GetLooseMin(), GetLooseMax()), this));
+
+	while (!lHeap.empty()) {
+		std::pop_heap(lHeap.begin(), lHeap.end(), std::greater<OctantDistance>());
+		OctantDistance next = lHeap.back();
+		lHeap.pop_back();
+
+		float fBound = lBest.size() < a_uCount ? FLT_MAX : lBest.back().first;
+		if (next.first > fBound)
+			break;
+
+		MyOctant* pOctant = next.second;
+		for (uint i = 0; i < pOctant->m_EntityList.size(); i++) {
+			uint uEntity = pOctant->m_EntityList[i];
+			MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(uEntity)->GetRigidBody();
+			std::pair<float, uint> candidate(DistanceToBox2(a_v3Point, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal()), uEntity);
+			if (lBest.size() == a_uCount && candidate.first >= lBest.back().first)
+				continue;
+			//entities in several leaves are only counted once
+			if (std::find(lBest.begin(), lBest.end(), candidate) != lBest.end())
+				continue;
+			lBest.insert(std::upper_bound(lBest.begin(), lBest.end(), candidate), candidate);
+			if (lBest.size() > a_uCount)
+				lBest.pop_back();
+		}
+
+		for (int i = 0; i < pOctant->m_uChildren; i++) {
+			MyOctant* pChild = pOctant->m_pChild[i];
+			lHeap.push_back(OctantDistance(DistanceToBox2(a_v3Point, pChild->GetLooseMin(), pChild->GetLooseMax()), pChild));
+			std::push_heap(lHeap.begin(), lHeap.end(), std::greater<OctantDistance>());
+		}
+	}
+
+	std::vector<uint> lEntity;
+	for (uint i = 0; i < lBest.size(); i++) {
+		lEntity.push_back(lBest[i].second);
+	}
+	return lEntity;
+}
+
 //Constructors
-MyOctant::MyOctant(uint a_nMaxLevel, uint a_nIdealEntityCount)
+MyOctant::MyOctant(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness)
 {
 	//Initialize all values
 	Init();
 
+	//the root is always octant 0, the count is left over from the last tree
+	m_uOctantCount = 0;
 	m_uID = m_uOctantCount;
 	m_uMaxLevel = a_nMaxLevel;
 	m_uIdealEntityCount = a_nIdealEntityCount;
-	m_uOctantCount = 0;
+	m_fLooseness = glm::max(a_fLooseness, 1.0f);
 
 	//setting octree root and children
 	m_pRoot = this;
@@ -449,8 +797,11 @@ MyOctant& MyOctant::operator=(MyOctant const& other) {
 //destructor which can be used more than once at the end of the program
 void MyOctant::Release(void)
 {
-	if (m_uLevel == 0)
+	if (m_uLevel == 0) {
 		KillBranches();
+		//the pairs came from this tree
+		m_pEntityMngr->ClearPairList();
+	}
 
 	//resets variables
 	m_uChildren = 0;
@@ -1,16 +1,17 @@
 #ifndef _MYOCTANTCLASS_H_
 #define _MYOCTANTCLASS_H_
 
-#include "MyEntityManager.h"
+#include "MySpatialIndex.h"
 
 namespace Simplex
 {
 
-	class MyOctant
+	class MyOctant : public MySpatialIndex
 	{
 		static uint m_uOctantCount; //number of octants
 		static uint m_uMaxLevel; //max octant level
 		static uint m_uIdealEntityCount; //how many entities the octant contains
+		static float m_fLooseness; //how much bigger than its cell an octant holds entities, 1 is a tight octree
 
 		uint m_uID = 0; //octant ID
 		uint m_uLevel = 0; //octant level
@@ -38,7 +39,8 @@ namespace Simplex
 
 	public:
 		//constructors
-		MyOctant(uint a_maxLevel = 2, uint a_nIdealEntityCount = 5);
+		//a looseness above 1 builds a loose octree, every entity lives in a single octant
+		MyOctant(uint a_maxLevel = 2, uint a_nIdealEntityCount = 5, float a_fLooseness = 1.0f);
 		MyOctant(vector3 a_v3Center, float a_fSize);
 		MyOctant(MyOctant const& other);
 		MyOctant& operator=(MyOctant const& other);
@@ -86,8 +88,22 @@ namespace Simplex
 
 		void AssignIDtoEntity(void);
 
+		//gives the entity manager the pairs of entities sharing a leaf
+		void ConstructPairList(void);
+
 		uint GetOctantCount(void);
 
+		//spatial index interface, Update rebuilds the tree within the same bounds
+		void Update(void);
+		uint GetNodeCount(void);
+		String GetName(void);
+		//spatial queries over this octant and its children
+		int RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance);
+		std::vector<uint> RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction);
+		std::vector<uint> QueryAABB(vector3 a_v3Min, vector3 a_v3Max);
+		std::vector<uint> QuerySphere(vector3 a_v3Center, float a_fRadius);
+		std::vector<uint> QueryNearest(vector3 a_v3Point, uint a_uCount);
+
 	private:
 		void Release(void); //destroys octree
 
@@ -95,6 +111,16 @@ namespace Simplex
 
 		void ConstructList(void); //recursive construction of list
 
+		//loose bounds of the octant
+		vector3 GetLooseMin(void);
+		vector3 GetLooseMax(void);
+
+		//places the entity in the deepest octant whose loose bounds hold it
+		void AssignLoose(uint a_uRBIndex);
+
+		//adds the pairs between the given octant and the octants of this branch that overlap it
+		void CollectLoosePairs(MyOctant* a_pOctant, std::vector<uint>& a_lPair);
+
 	};
 
 }
@@ -0,0 +1,149 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/07
+----------------------------------------------*/
+#ifndef __MYSPATIALINDEX_H_
+#define __MYSPATIALINDEX_H_
+
+#include "MyEntityManager.h"
+
+namespace Simplex
+{
+
+//Interface shared by the broad phase structures (octree, loose octree, AABB tree)
+class MySpatialIndex
+{
+public:
+	/*
+	Usage: destructor
+	Arguments: ---
+	Output: ---
+	*/
+	virtual ~MySpatialIndex(void) {}
+	/*
+	USAGE: Brings the structure up to date with the entities of the entity manager and gives
+		it the new candidate pairs, construction does the same
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	virtual void Update(void) = 0;
+	/*
+	USAGE: Gives the entity manager the pairs of entities that may be colliding
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	virtual void ConstructPairList(void) = 0;
+	/*
+	USAGE: Adds the nodes of the structure to the render list
+	ARGUMENTS: vector3 a_v3Color = C_YELLOW -> color of the nodes
+	OUTPUT: ---
+	*/
+	virtual void Display(vector3 a_v3Color = C_YELLOW) = 0;
+	/*
+	USAGE: Gets the number of nodes in the structure
+	ARGUMENTS: ---
+	OUTPUT: node count
+	*/
+	virtual uint GetNodeCount(void) = 0;
+	/*
+	USAGE: Gets the name of the structure, for display
+	ARGUMENTS: ---
+	OUTPUT: name
+	*/
+	virtual String GetName(void) = 0;
+	/*
+	USAGE: Finds the first entity the ray hits, visiting the nodes front to back and stopping once
+		the closest hit is nearer than the next node
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> start of the ray
+	-	vector3 a_v3Direction -> direction of the ray
+	-	float& a_fDistance -> distance from the origin to the hit, untouched if nothing is hit
+	OUTPUT: index of the entity in the entity manager, -1 if nothing is hit
+	*/
+	virtual int RayCast(vector3 a_v3Origin, vector3 a_v3Direction, float& a_fDistance) = 0;
+	/*
+	USAGE: Finds every entity the ray hits
+	ARGUMENTS:
+	-	vector3 a_v3Origin -> start of the ray
+	-	vector3 a_v3Direction -> direction of the ray
+	OUTPUT: indices of the entities, nearest first
+	*/
+	virtual std::vector<uint> RayCastAll(vector3 a_v3Origin, vector3 a_v3Direction) = 0;
+	/*
+	USAGE: Finds the entities whose ARBB overlaps the box
+	ARGUMENTS:
+	-	vector3 a_v3Min -> minimum corner of the box
+	-	vector3 a_v3Max -> maximum corner of the box
+	OUTPUT: indices of the entities, sorted
+	*/
+	virtual std::vector<uint> QueryAABB(vector3 a_v3Min, vector3 a_v3Max) = 0;
+	/*
+	USAGE: Finds the entities whose ARBB overlaps the sphere
+	ARGUMENTS:
+	-	vector3 a_v3Center -> center of the sphere
+	-	float a_fRadius -> radius of the sphere
+	OUTPUT: indices of the entities, sorted
+	*/
+	virtual std::vector<uint> QuerySphere(vector3 a_v3Center, float a_fRadius) = 0;
+	/*
+	USAGE: Finds the entities whose ARBB is closest to the point
+	ARGUMENTS:
+	-	vector3 a_v3Point -> point to measure from
+	-	uint a_uCount -> how many entities to find
+	OUTPUT: indices of the entities, nearest first
+	*/
+	virtual std::vector<uint> QueryNearest(vector3 a_v3Point, uint a_uCount) = 0;
+
+protected:
+	/*
+	Usage: Slab test of a ray against a box
+	Arguments:
+	-	vector3 a_v3Origin -> start of the ray
+	-	vector3 a_v3Inverse -> one over each component of the normalized direction, infinite on the axes
+		the ray does not move along
+	-	vector3 a_v3Min -> minimum corner of the box
+	-	vector3 a_v3Max -> maximum corner of the box
+	-	float a_fMaxDistance -> hits past this distance are ignored
+	-	float& a_fDistance -> distance where the ray enters the box, 0 if it starts inside
+	Output: the ray hits the box
+	*/
+	static bool RayHitsBox(vector3 a_v3Origin, vector3 a_v3Inverse, vector3 a_v3Min, vector3 a_v3Max,
+		float a_fMaxDistance, float& a_fDistance)
+	{
+		float fEnter = 0.0f;
+		float fExit = a_fMaxDistance;
+		for (uint i = 0; i < 3; ++i)
+		{
+			//a ray parallel to the slab never crosses it, 0 * inf would make the slab NaN
+			if (std::isinf(a_v3Inverse[i]))
+			{
+				if (a_v3Origin[i] < a_v3Min[i] || a_v3Origin[i] > a_v3Max[i])
+					return false;
+				continue;
+			}
+			float fNear = (a_v3Min[i] - a_v3Origin[i]) * a_v3Inverse[i];
+			float fFar = (a_v3Max[i] - a_v3Origin[i]) * a_v3Inverse[i];
+			fEnter = glm::max(fEnter, glm::min(fNear, fFar));
+			fExit = glm::min(fExit, glm::max(fNear, fFar));
+		}
+		a_fDistance = fEnter;
+		return fEnter <= fExit;
+	}
+	/*
+	Usage: Squared distance from a point to a box, 0 if the point is inside
+	Arguments:
+	-	vector3 a_v3Point -> point
+	-	vector3 a_v3Min -> minimum corner of the box
+	-	vector3 a_v3Max -> maximum corner of the box
+	Output: squared distance
+	*/
+	static float DistanceToBox2(vector3 a_v3Point, vector3 a_v3Min, vector3 a_v3Max)
+	{
+		vector3 v3Delta = a_v3Point - glm::clamp(a_v3Point, a_v3Min, a_v3Max);
+		return glm::dot(v3Delta, v3Delta);
+	}
+};
+
+} //namespace Simplex
+
+#endif //__MYSPATIALINDEX_H_
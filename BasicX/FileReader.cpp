@@ -190,17 +190,21 @@ bool FileReader::ReadBool(void)
 
 String FileReader::ReadString(void)
 {
-	char* output;
+	String output;
 	int nSize = 0;
 	if (m_iStream.is_open())
 	{
 		m_iStream.read((char*)&nSize, sizeof(int));
-		output = new char[nSize + 1];
-		m_iStream.read((char*)output, sizeof(char) * nSize);
-		output[nSize] = '\0';
+		//read straight into the string, a bad size from a broken file reads nothing
+		if (m_iStream && nSize > 0)
+		{
+			output.resize(nSize);
+			m_iStream.read(&output[0], sizeof(char) * nSize);
+			output.resize(static_cast<size_t>(m_iStream.gcount()));
+		}
 	}
-	return String(output);
- }
+	return output;
+}
 
 BTO_OUTPUT FileReader::WriteLine(String a_sStringInput)
 {
@@ -0,0 +1,313 @@
+#include "BasicX\System\GLStateManager.h"
+using namespace BasicX;
+//  GLStateManager
+GLStateManager* GLStateManager::m_pInstance = nullptr;
+GLStateManager* GLStateManager::GetInstance(void)
+{
+	if (m_pInstance == nullptr)
+	{
+		m_pInstance = new GLStateManager();
+	}
+	return m_pInstance;
+}
+void GLStateManager::ReleaseInstance(void)
+{
+	if (m_pInstance != nullptr)
+	{
+		delete m_pInstance;
+		m_pInstance = nullptr;
+	}
+}
+void GLStateManager::Init(void)
+{
+	Invalidate();
+
+	m_uCallCount = 0;
+	m_uSavedCount = 0;
+	m_uLastCallCount = 0;
+	m_uLastSavedCount = 0;
+}
+void GLStateManager::Release(void)
+{
+	//No pointers allocated, so nothing to do here
+}
+//The big 3
+GLStateManager::GLStateManager(void) { Init(); }
+GLStateManager::GLStateManager(GLStateManager const& other) { }
+GLStateManager& GLStateManager::operator=(GLStateManager const& other) { return *this; }
+GLStateManager::~GLStateManager(void) { Release(); }
+//Methods
+void GLStateManager::UseProgram(GLuint a_uProgram)
+{
+	if (m_uProgram == a_uProgram)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glUseProgram(a_uProgram);
+	m_uProgram = a_uProgram;
+	++m_uCallCount;
+}
+void GLStateManager::BindVertexArray(GLuint a_uVertexArray)
+{
+	if (m_uVertexArray == a_uVertexArray)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glBindVertexArray(a_uVertexArray);
+	m_uVertexArray = a_uVertexArray;
+	++m_uCallCount;
+}
+void GLStateManager::BindTexture(uint a_uUnit, GLuint a_uTexture, bool a_bActive)
+{
+	//units past the ones we track are always sent
+	if (a_uUnit >= GL_STATE_TEXTURE_UNITS)
+	{
+		glActiveTexture(GL_TEXTURE0 + a_uUnit);
+		glBindTexture(GL_TEXTURE_2D, a_uTexture);
+		m_uActiveUnit = a_uUnit;
+		m_uCallCount += 2;
+		return;
+	}
+
+	//for sampling the active unit only matters for the bind, skip both if the texture is already there
+	if (m_uTextureArray[a_uUnit] == a_uTexture && (!a_bActive || m_uActiveUnit == a_uUnit))
+	{
+		m_uSavedCount += 2;
+		return;
+	}
+	if (m_uActiveUnit != a_uUnit)
+	{
+		glActiveTexture(GL_TEXTURE0 + a_uUnit);
+		m_uActiveUnit = a_uUnit;
+		++m_uCallCount;
+	}
+	else
+		++m_uSavedCount;
+	if (m_uTextureArray[a_uUnit] == a_uTexture)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glBindTexture(GL_TEXTURE_2D, a_uTexture);
+	m_uTextureArray[a_uUnit] = a_uTexture;
+	++m_uCallCount;
+}
+void GLStateManager::SetPolygonMode(GLenum a_eMode)
+{
+	if (m_ePolygonMode == a_eMode)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glPolygonMode(GL_FRONT_AND_BACK, a_eMode);
+	m_ePolygonMode = a_eMode;
+	++m_uCallCount;
+}
+void GLStateManager::SetPolygonOffset(float a_fFactor, float a_fUnits)
+{
+	vector2 v2Offset(a_fFactor, a_fUnits);
+	if (m_bPolygonOffset && m_v2PolygonOffset == v2Offset)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glPolygonOffset(a_fFactor, a_fUnits);
+	m_v2PolygonOffset = v2Offset;
+	m_bPolygonOffset = true;
+	++m_uCallCount;
+}
+void GLStateManager::SetCapability(GLenum a_eCapability, bool a_bEnable)
+{
+	uint uIndex = GetCapabilityIndex(a_eCapability);
+	if (uIndex < CAPABILITY_COUNT && m_nCapabilityArray[uIndex] == static_cast<int>(a_bEnable))
+	{
+		++m_uSavedCount;
+		return;
+	}
+	if (a_bEnable)
+		glEnable(a_eCapability);
+	else
+		glDisable(a_eCapability);
+	if (uIndex < CAPABILITY_COUNT)
+		m_nCapabilityArray[uIndex] = static_cast<int>(a_bEnable);
+	++m_uCallCount;
+}
+bool GLStateManager::IsCapabilityEnabled(GLenum a_eCapability)
+{
+	uint uIndex = GetCapabilityIndex(a_eCapability);
+	if (uIndex < CAPABILITY_COUNT && m_nCapabilityArray[uIndex] != -1)
+		return m_nCapabilityArray[uIndex] == 1;
+
+	//unknown, ask once and remember it
+	bool bEnabled = glIsEnabled(a_eCapability) == GL_TRUE;
+	if (uIndex < CAPABILITY_COUNT)
+		m_nCapabilityArray[uIndex] = static_cast<int>(bEnabled);
+	return bEnabled;
+}
+void GLStateManager::SetBlendFunc(GLenum a_eSource, GLenum a_eDestination)
+{
+	if (m_eBlendSrc == a_eSource && m_eBlendDst == a_eDestination)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glBlendFunc(a_eSource, a_eDestination);
+	m_eBlendSrc = a_eSource;
+	m_eBlendDst = a_eDestination;
+	++m_uCallCount;
+}
+void GLStateManager::GetBlendFunc(GLenum& a_eSource, GLenum& a_eDestination)
+{
+	//unknown, ask once and remember it
+	if (m_eBlendSrc == GL_NONE)
+	{
+		GLint nSource, nDestination;
+		glGetIntegerv(GL_BLEND_SRC_RGB, &nSource);
+		glGetIntegerv(GL_BLEND_DST_RGB, &nDestination);
+		m_eBlendSrc = static_cast<GLenum>(nSource);
+		m_eBlendDst = static_cast<GLenum>(nDestination);
+	}
+	a_eSource = m_eBlendSrc;
+	a_eDestination = m_eBlendDst;
+}
+void GLStateManager::SetBlendEquation(GLenum a_eEquation)
+{
+	if (m_eBlendEquation == a_eEquation)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glBlendEquation(a_eEquation);
+	m_eBlendEquation = a_eEquation;
+	++m_uCallCount;
+}
+GLenum GLStateManager::GetBlendEquation(void)
+{
+	//unknown, ask once and remember it
+	if (m_eBlendEquation == GL_NONE)
+	{
+		GLint nEquation;
+		glGetIntegerv(GL_BLEND_EQUATION_RGB, &nEquation);
+		m_eBlendEquation = static_cast<GLenum>(nEquation);
+	}
+	return m_eBlendEquation;
+}
+void GLStateManager::SetViewport(GLint a_nX, GLint a_nY, GLsizei a_nWidth, GLsizei a_nHeight)
+{
+	if (m_bViewport && m_nViewportArray[0] == a_nX && m_nViewportArray[1] == a_nY &&
+		m_nViewportArray[2] == a_nWidth && m_nViewportArray[3] == a_nHeight)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glViewport(a_nX, a_nY, a_nWidth, a_nHeight);
+	m_nViewportArray[0] = a_nX;
+	m_nViewportArray[1] = a_nY;
+	m_nViewportArray[2] = a_nWidth;
+	m_nViewportArray[3] = a_nHeight;
+	m_bViewport = true;
+	++m_uCallCount;
+}
+void GLStateManager::GetViewport(GLint* a_nViewport)
+{
+	//unknown, ask once and remember it
+	if (!m_bViewport)
+	{
+		glGetIntegerv(GL_VIEWPORT, m_nViewportArray);
+		m_bViewport = true;
+	}
+	memcpy(a_nViewport, m_nViewportArray, sizeof(GLint) * 4);
+}
+void GLStateManager::SetScissor(GLint a_nX, GLint a_nY, GLsizei a_nWidth, GLsizei a_nHeight)
+{
+	if (m_bScissor && m_nScissorArray[0] == a_nX && m_nScissorArray[1] == a_nY &&
+		m_nScissorArray[2] == a_nWidth && m_nScissorArray[3] == a_nHeight)
+	{
+		++m_uSavedCount;
+		return;
+	}
+	glScissor(a_nX, a_nY, a_nWidth, a_nHeight);
+	m_nScissorArray[0] = a_nX;
+	m_nScissorArray[1] = a_nY;
+	m_nScissorArray[2] = a_nWidth;
+	m_nScissorArray[3] = a_nHeight;
+	m_bScissor = true;
+	++m_uCallCount;
+}
+void GLStateManager::GetScissor(GLint* a_nScissor)
+{
+	//unknown, ask once and remember it
+	if (!m_bScissor)
+	{
+		glGetIntegerv(GL_SCISSOR_BOX, m_nScissorArray);
+		m_bScissor = true;
+	}
+	memcpy(a_nScissor, m_nScissorArray, sizeof(GLint) * 4);
+}
+void GLStateManager::ForgetProgram(GLuint a_uProgram)
+{
+	//a deleted program stays in use until another one replaces it, the next use has to be sent
+	if (m_uProgram == a_uProgram)
+		m_uProgram = GL_INVALID_INDEX;
+}
+void GLStateManager::ForgetVertexArray(GLuint a_uVertexArray)
+{
+	//OpenGL binds 0 when the bound vertex array is deleted
+	if (m_uVertexArray == a_uVertexArray)
+		m_uVertexArray = 0;
+}
+void GLStateManager::ForgetTexture(GLuint a_uTexture)
+{
+	//OpenGL binds 0 to every unit that had the deleted texture
+	for (uint uUnit = 0; uUnit < GL_STATE_TEXTURE_UNITS; ++uUnit)
+	{
+		if (m_uTextureArray[uUnit] == a_uTexture)
+			m_uTextureArray[uUnit] = 0;
+	}
+}
+void GLStateManager::Invalidate(void)
+{
+	m_uProgram = GL_INVALID_INDEX;
+	m_uVertexArray = GL_INVALID_INDEX;
+	m_uActiveUnit = GL_INVALID_INDEX;
+	for (uint uUnit = 0; uUnit < GL_STATE_TEXTURE_UNITS; ++uUnit)
+		m_uTextureArray[uUnit] = GL_INVALID_INDEX;
+	m_ePolygonMode = GL_NONE;
+	m_bPolygonOffset = false;
+	for (uint uCapability = 0; uCapability < CAPABILITY_COUNT; ++uCapability)
+		m_nCapabilityArray[uCapability] = -1;
+	m_eBlendSrc = GL_NONE;
+	m_eBlendDst = GL_NONE;
+	m_eBlendEquation = GL_NONE;
+	m_bViewport = false;
+	m_bScissor = false;
+}
+void GLStateManager::ResetCounters(void)
+{
+	m_uLastCallCount = m_uCallCount;
+	m_uLastSavedCount = m_uSavedCount;
+	m_uCallCount = 0;
+	m_uSavedCount = 0;
+}
+uint GLStateManager::GetCallCount(void) { return m_uLastCallCount; }
+uint GLStateManager::GetSavedCount(void) { return m_uLastSavedCount; }
+uint GLStateManager::GetCapabilityIndex(GLenum a_eCapability)
+{
+	switch (a_eCapability)
+	{
+	case GL_BLEND:
+		return CAPABILITY_BLEND;
+	case GL_DEPTH_TEST:
+		return CAPABILITY_DEPTH_TEST;
+	case GL_CULL_FACE:
+		return CAPABILITY_CULL_FACE;
+	case GL_SCISSOR_TEST:
+		return CAPABILITY_SCISSOR_TEST;
+	case GL_POLYGON_OFFSET_LINE:
+		return CAPABILITY_POLYGON_OFFSET_LINE;
+	default:
+		return CAPABILITY_COUNT;
+	}
+}
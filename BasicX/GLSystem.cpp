@@ -1,5 +1,6 @@
 #include "BasicX\System\GLSystem.h"
 #include "BasicX\System\SystemSingleton.h"
+#include "BasicX\System\GLStateManager.h"
 
 #include <iostream>
 using namespace BasicX;
@@ -208,13 +209,14 @@ HRESULT GLSystem::InitGLDevice(HWND g_hWnd)
 	std::cout << "Using OpenGL: " << glVersion[0] << "." << glVersion[1] << std::endl; // Output which version of OpenGL we are using
 	m_fGLVersion = static_cast <float>(glVersion[0]) + (static_cast <float>(glVersion[1]) * 0.1f);
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLStateManager* pGLState = GLStateManager::GetInstance();
+	pGLState->SetCapability(GL_BLEND, true);
+	pGLState->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	glEnable(GL_DEPTH_TEST);	// Enables Depth Testing
+	pGLState->SetCapability(GL_DEPTH_TEST, true);	// Enables Depth Testing
 	glDepthFunc(GL_LEQUAL);		// The Type Of Depth Testing To Do
 
-	glEnable(GL_CULL_FACE);
+	pGLState->SetCapability(GL_CULL_FACE, true);
 
 	printf("\n");
 	
@@ -252,7 +254,7 @@ bool GLSystem::UpdateRenderTarget(GLuint& a_nFrameBuffer, GLuint& a_nDepthBuffer
 
 	glBindFramebuffer(GL_FRAMEBUFFER, a_nFrameBuffer);
 
-	glBindTexture(GL_TEXTURE_2D, a_nTextureIndex);
+	GLStateManager::GetInstance()->BindTexture(0, a_nTextureIndex, true);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, 0);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
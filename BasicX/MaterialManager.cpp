@@ -51,8 +51,9 @@ int MaterialManager::AddMaterial(Material input)
 		m_materialList.push_back(pMaterial);
 		nMaterial = m_materialList.size() -1;
 		m_map[pMaterial->GetName()] = nMaterial;
+		//only the new material needs its maps, the others are already loaded
+		pMaterial->LoadMaps();
 	}
-	ReloadMaps();
 	return nMaterial;
 }
 int MaterialManager::AddMaterial(String a_sName)
@@ -105,12 +106,17 @@ int MaterialManager::GetMaterialCount(void)
 {
 	return static_cast<int>(m_materialList.size());
 }
-void MaterialManager::ReloadMaps()
+void MaterialManager::ReloadMaps(bool a_bAll)
 {
+	//files may have been added since the last time, look for them again
+	if (a_bAll)
+		TextureManager::GetInstance()->ClearResolvedTextures();
+
 	int nMaterials = GetMaterialCount();
 	for(int i = 0; i < nMaterials; i++)
 	{
-		m_materialList[i]->LoadMaps();
+		if (a_bAll || m_materialList[i]->AreMapsDirty())
+			m_materialList[i]->LoadMaps();
 	}
 	return;
 }
@@ -16,6 +16,7 @@ void Mesh::Init(void)
 	
 	m_VAO = 0;
 	m_VBO = 0;
+	m_ColorVBO = 0;
 
 	m_v3Tint = DEFAULT_V3NEG;
 
@@ -37,9 +38,9 @@ void Mesh::Swap(Mesh& other)
 
 	std::swap(m_VAO, other.m_VAO);
 	std::swap(m_VBO, other.m_VBO);
+	std::swap(m_ColorVBO, other.m_ColorVBO);
 	std::swap(m_nShader, other.m_nShader);
 
-	std::swap(m_lVertex, other.m_lVertex);
 	std::swap(m_lVertexPos, other.m_lVertexPos);
 	std::swap(m_lVertexCol, other.m_lVertexCol);
 	std::swap(m_lVertexNor, other.m_lVertexNor);
@@ -65,10 +66,15 @@ void Mesh::Release(void)
 	if (m_VBO > 0)
 		glDeleteBuffers(1, &m_VBO);
 
+	if (m_ColorVBO > 0)
+		glDeleteBuffers(1, &m_ColorVBO);
+
 	if(m_VAO > 0 )
+	{
+		GLStateManager::GetInstance()->ForgetVertexArray(m_VAO);
 		glDeleteVertexArrays(1, &m_VAO);
+	}
 	
-	m_lVertex.clear();
 	m_lVertexPos.clear();
 	m_lVertexCol.clear();
 	m_lVertexNor.clear();
@@ -99,6 +105,7 @@ Mesh::Mesh(Mesh& other)
 
 	m_VAO = other.m_VAO;
 	m_VBO = other.m_VBO;
+	m_ColorVBO = other.m_ColorVBO;
 
 	m_nShader = other.m_nShader;
 
@@ -134,6 +141,7 @@ void Mesh::Instantiate(Mesh* const other)
 
 	m_VAO = other->m_VAO;
 	m_VBO = other->m_VBO;
+	m_ColorVBO = other->m_ColorVBO;
 
 	m_nShader = other->m_nShader;
 
@@ -375,6 +383,7 @@ void Mesh::DisconnectOpenGL3X(void)
 {
 	m_VAO = 0;
 	m_VBO = 0;
+	m_ColorVBO = 0;
 }
 void Mesh::CompleteMesh(vector3 a_v3Color)
 {
@@ -398,37 +407,55 @@ void Mesh::CompleteMesh(vector3 a_v3Color)
 	for(uint nUV = nUVTotal; nUV < m_uVertexCount; nUV++)
 		m_lVertexUV.push_back(vector3(1.0f, 0.0f, 0.0f));
 }
-void Mesh::CompileOpenGL3X(void)
+void Mesh::InterleaveVertices(vector3* a_pOutput)
 {
-	if(m_bBinded)
-		return;
-
-	if(m_uVertexCount == 0)
-		return;
-
-	CompleteMesh();
-
 	for (uint i = 0; i < m_uVertexCount; i++)
 	{
 		//Position
-		m_lVertex.push_back(m_lVertexPos[i]);
+		*a_pOutput++ = m_lVertexPos[i];
 		//Color
-		m_lVertex.push_back(m_lVertexCol[i]);
+		*a_pOutput++ = m_lVertexCol[i];
 		//UV
-		m_lVertex.push_back(m_lVertexUV[i]);
+		*a_pOutput++ = m_lVertexUV[i];
 		//Normal
-		m_lVertex.push_back(m_lVertexNor[i]);
+		*a_pOutput++ = m_lVertexNor[i];
 		//Bi-Normal
-		m_lVertex.push_back(m_lVertexBin[i]);
+		*a_pOutput++ = m_lVertexBin[i];
 		//Tangent
-		m_lVertex.push_back(m_lVertexTan[i]);
+		*a_pOutput++ = m_lVertexTan[i];
 	}
+}
+void Mesh::CompileOpenGL3X(void)
+{
+	if(m_bBinded)
+		return;
+
+	if(m_uVertexCount == 0)
+		return;
+
+	CompleteMesh();
+
 	glGenVertexArrays( 1, &m_VAO );//Generate vertex array object
 	glGenBuffers(1, &m_VBO);//Generate Vertex Buffered Object
 	
-	glBindVertexArray( m_VAO );//Bind the VAO
+	GLStateManager* pGLState = GLStateManager::GetInstance();
+	pGLState->BindVertexArray(m_VAO);//Bind the VAO
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);//Bind the VBO
-	glBufferData(GL_ARRAY_BUFFER, m_uVertexCount * 6 * sizeof(vector3), &m_lVertex[0], GL_STATIC_DRAW);//Generate space for the VBO
+	GLsizeiptr nSize = m_uVertexCount * 6 * sizeof(vector3);
+	glBufferData(GL_ARRAY_BUFFER, nSize, nullptr, GL_STATIC_DRAW);//Generate space for the VBO
+
+	//interleave straight into the buffer instead of composing a copy of the mesh first
+	vector3* pMapped = static_cast<vector3*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, nSize,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	if (pMapped != nullptr)
+		InterleaveVertices(pMapped);
+	//the mapping failed or its contents were lost (glUnmapBuffer returns false), send it the slow way
+	if (pMapped == nullptr || glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+	{
+		std::vector<vector3> lVertex(m_uVertexCount * 6);
+		InterleaveVertices(&lVertex[0]);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, nSize, &lVertex[0]);
+	}
 
 	// Position attribute
 	glEnableVertexAttribArray(0);
@@ -454,6 +481,12 @@ void Mesh::CompileOpenGL3X(void)
 	glEnableVertexAttribArray(5);
 	glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(vector3), (GLvoid*)(5 * sizeof(vector3)));
 
+	// Instance color attribute, advances once per instance and is filled at render time
+	glGenBuffers(1, &m_ColorVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_ColorVBO);
+	glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(vector3), (GLvoid*)0);
+	glVertexAttribDivisor(6, 1);
+
 	if(m_uMaterialIndex < 0)
 	{
 		if(m_pMatMngr->GetMaterialCount() < 1)
@@ -468,7 +501,7 @@ void Mesh::CompileOpenGL3X(void)
 
 	m_bBinded = true;
 
-	glBindVertexArray(0); // Unbind VAO
+	pGLState->BindVertexArray(0); // Unbind VAO
 
 	return;
 }
@@ -715,7 +748,7 @@ void Mesh::Render(matrix4 a_mProjection, matrix4 a_mView, matrix4 a_mWorld, vect
 {
 	Render(a_mProjection, a_mView, glm::value_ptr(a_mWorld), 1, a_v3CameraPosition, a_RenderOption);
 }
-void Mesh::Render( matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition, int a_RenderOption)
+void Mesh::Render( matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition, int a_RenderOption, float* a_fColorArray)
 {
 	//check if the shape has been binded
 	if (!m_bBinded)
@@ -734,7 +767,7 @@ void Mesh::Render( matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray
 	if (a_RenderOption & BTO_RENDER::RENDER_SOLID)
 	{
 		solid = true;
-		RenderSolid(a_mProjection, a_mView, a_fMatrixArray, a_nInstances, a_v3CameraPosition);
+		RenderSolid(a_mProjection, a_mView, a_fMatrixArray, a_nInstances, a_v3CameraPosition, a_fColorArray);
 	}
 	if (a_RenderOption & BTO_RENDER::RENDER_WIRE)
 	{
@@ -743,20 +776,45 @@ void Mesh::Render( matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray
 			vector3 wireframe;
 			wireframe = m_v3Wireframe;
 			std::swap(wireframe, m_v3Wireframe);
-			RenderWire(a_mProjection, a_mView, a_fMatrixArray, a_nInstances);
+			RenderWire(a_mProjection, a_mView, a_fMatrixArray, a_nInstances, a_fColorArray);
 			m_v3Wireframe = wireframe;
 		}
-		else
+		else //over the solid the instance colors would hide the lines
 			RenderWire(a_mProjection, a_mView, a_fMatrixArray, a_nInstances);
 	}
 }
-void Mesh::RenderWire(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances)
+void Mesh::BindInstanceColors(float* a_fColorArray, int a_nInstances)
+{
+	//no colors, every instance reads the same constant white
+	if (a_fColorArray == nullptr || m_ColorVBO == 0)
+	{
+		glDisableVertexAttribArray(6);
+		glVertexAttrib3f(6, 1.0f, 1.0f, 1.0f);
+		return;
+	}
+
+	//orphan the old storage so we do not wait for the last frame to finish with it
+	glBindBuffer(GL_ARRAY_BUFFER, m_ColorVBO);
+	glBufferData(GL_ARRAY_BUFFER, a_nInstances * sizeof(vector3), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, a_nInstances * sizeof(vector3), a_fColorArray);
+	glEnableVertexAttribArray(6);
+}
+void Mesh::SetInstanceColorSection(float* a_fColorArray, uint a_uFirstInstance)
+{
+	//gl_InstanceID starts over on every draw so the attribute starts where the section does
+	if (a_fColorArray == nullptr || m_ColorVBO == 0)
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_ColorVBO);
+	glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(vector3), (GLvoid*)(a_uFirstInstance * sizeof(vector3)));
+}
+void Mesh::RenderWire(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, float* a_fColorArray)
 {
 	GLuint nShader = m_pShaderMngr->GetShaderID("Wireframe");
 	// Use the buffer and shader
-	glUseProgram(nShader);
-
-	glBindVertexArray(m_VAO);
+	GLStateManager* pGLState = GLStateManager::GetInstance();
+	pGLState->UseProgram(nShader);
+	pGLState->BindVertexArray(m_VAO);
 
 	// Get the GPU variables by their name and hook them to CPU variables
 	GLuint VP = glGetUniformLocation(nShader, "VP");
@@ -766,39 +824,42 @@ void Mesh::RenderWire(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixAr
 	//Final Projection of the Camera
 	matrix4 m4VP = a_mProjection * a_mView;
 	glUniformMatrix4fv(VP, 1, GL_FALSE, glm::value_ptr(m4VP));
-	glUniform3f(vWireframe, m_v3Wireframe.x, m_v3Wireframe.y, m_v3Wireframe.z);
+	//the instance colors replace the color of the wireframe
+	if (a_fColorArray != nullptr)
+		glUniform3f(vWireframe, 1.0f, 1.0f, 1.0f);
+	else
+		glUniform3f(vWireframe, m_v3Wireframe.x, m_v3Wireframe.y, m_v3Wireframe.z);
+	BindInstanceColors(a_fColorArray, a_nInstances);
 
 	//Number of Instances
 	uint nSections = a_nInstances / 250;
 	uint nRemainders = a_nInstances - (250 * nSections);
 	uint nInstances = a_nInstances;
-	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	glEnable(GL_POLYGON_OFFSET_LINE);
-	glPolygonOffset(-1.f, -1.f);
+	//the offset only applies to lines so it can stay enabled for the solid draws
+	pGLState->SetPolygonMode(GL_LINE);
+	pGLState->SetCapability(GL_POLYGON_OFFSET_LINE, true);
+	pGLState->SetPolygonOffset(-1.f, -1.f);
 	for (uint n = 0; n < nSections; n++)
 	{
 		glUniformMatrix4fv(m4ToWorld, 250, GL_FALSE, &a_fMatrixArray[n * 250 * 16]);
+		SetInstanceColorSection(a_fColorArray, n * 250);
 		//Draw
 		glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, 250);
 		m_uRenderCalls++;
 	}
 
 	glUniformMatrix4fv(m4ToWorld, nRemainders, GL_FALSE, &a_fMatrixArray[nSections * 250 * 16]);
+	SetInstanceColorSection(a_fColorArray, nSections * 250);
 	glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, nRemainders);
 	m_uRenderCalls++;
-
-	glDisable(GL_POLYGON_OFFSET_LINE);
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);//Set rendering mode back to fill
-
-	glBindVertexArray(0);
 }
-void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition)
+void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition, float* a_fColorArray)
 {
 	GLuint nShader = GetShaderIndex();
 	// Use the buffer and shader
-	glUseProgram(nShader);
-
-	glBindVertexArray(m_VAO);
+	GLStateManager* pGLState = GLStateManager::GetInstance();
+	pGLState->UseProgram(nShader);
+	pGLState->BindVertexArray(m_VAO);
 
 	// Get the GPU variables by their name and hook them to CPU variables
 	GLuint VP = glGetUniformLocation(nShader, "VP");
@@ -857,9 +918,8 @@ void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixA
 		//if (m_pMatMngr->m_lMaterial[nMaterialIndex]->GetDiffuseMapName() != "NULL")
 		if (index > 0)
 		{
-			glActiveTexture(GL_TEXTURE0);
 			//glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_lMaterial[nMaterialIndex]->GetDiffuseMap());
-			glBindTexture(GL_TEXTURE_2D, index);
+			pGLState->BindTexture(0, index);
 			glUniform1i(TextureID, 0);
 			nTextures += 1;
 		}
@@ -869,9 +929,8 @@ void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixA
 		//if (m_pMatMngr->m_lMaterial[nMaterialIndex]->GetNormalMapName() != "NULL")
 		if (index > 0)
 		{
-			glActiveTexture(GL_TEXTURE1);
 			//glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_lMaterial[nMaterialIndex]->GetNormalMap());
-			glBindTexture(GL_TEXTURE_2D, index);
+			pGLState->BindTexture(1, index);
 			glUniform1i(NormalID, 1);
 			nTextures += 2;
 		}
@@ -880,38 +939,306 @@ void Mesh::RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixA
 		index = m_pMatMngr->GetSpecularMap(nMaterialIndex);
 		//if (m_pMatMngr->m_lMaterial[nMaterialIndex]->GetSpecularMapName() != "NULL")
 		{
-			glActiveTexture(GL_TEXTURE2);
 			//glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_lMaterial[nMaterialIndex]->GetSpecularMap());
-			glBindTexture(GL_TEXTURE_2D, index);
+			pGLState->BindTexture(2, index);
 			glUniform1i(SpecularID, 2);
 			nTextures += 4;
 		}
 	}
 	glUniform1i(nTexture, nTextures);
 
+	BindInstanceColors(a_fColorArray, a_nInstances);
+
 	//Number of Instances
 	uint nSections = a_nInstances / 250;
 	uint nRemainders = a_nInstances - (250 * nSections);
 	uint nInstances = a_nInstances;
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	pGLState->SetPolygonMode(GL_FILL);
 	for (uint n = 0; n < nSections; n++)
 	{
 		glUniform1i(gl_nInstances, 250);
 		glUniformMatrix4fv(m4ToWorld, 250, GL_FALSE, &a_fMatrixArray[n * 250 * 16]);
-		glUseProgram(nShader);
-		
+		SetInstanceColorSection(a_fColorArray, n * 250);
 		glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, 250);
 		m_uRenderCalls++;
 	}
 
 	glUniform1i(gl_nInstances, nRemainders);
 	glUniformMatrix4fv(m4ToWorld, nRemainders, GL_FALSE, &a_fMatrixArray[nSections * 250 * 16]);
+	SetInstanceColorSection(a_fColorArray, nSections * 250);
 	glDrawArraysInstanced(GL_TRIANGLES, 0, m_uVertexCount, nRemainders);
 	m_uRenderCalls++;
-	//For the remainder
-	glDisable(GL_TEXTURE2);
-	glDisable(GL_TEXTURE1);
-	glDisable(GL_TEXTURE0);
+}
+//Level of Detail
+void Mesh::GetBoundingSphere(vector3& a_v3Center, float& a_fRadius)
+{
+	//copies share the vertices of their original
+	Mesh* pGeometry = this;
+	while (pGeometry->m_pOriginal != nullptr)
+		pGeometry = pGeometry->m_pOriginal;
+
+	a_v3Center = vector3(0.0f);
+	a_fRadius = 0.0f;
+	uint uCount = pGeometry->m_lVertexPos.size();
+	if (uCount == 0)
+		return;
+
+	vector3 v3Min = pGeometry->m_lVertexPos[0];
+	vector3 v3Max = pGeometry->m_lVertexPos[0];
+	for (uint i = 1; i < uCount; ++i)
+	{
+		v3Min = glm::min(v3Min, pGeometry->m_lVertexPos[i]);
+		v3Max = glm::max(v3Max, pGeometry->m_lVertexPos[i]);
+	}
+	a_v3Center = (v3Min + v3Max) * 0.5f;
+	for (uint i = 0; i < uCount; ++i)
+		a_fRadius = glm::max(a_fRadius, glm::distance(a_v3Center, pGeometry->m_lVertexPos[i]));
+}
+void Mesh::GenerateSimplified(Mesh* const a_pSource, uint a_uTriangles)
+{
+	if (a_pSource == nullptr)
+		return;
+
+	//copies share the vertices of their original
+	Mesh* pGeometry = a_pSource;
+	while (pGeometry->m_pOriginal != nullptr)
+		pGeometry = pGeometry->m_pOriginal;
+	if (!pGeometry->m_bBinded)
+		return;
+
+	Release();
+	Init();
+
+	std::vector<vector3>& lCorner = pGeometry->m_lVertexPos;
+	uint uTriangleCount = pGeometry->m_uVertexCount / 3;
 
-	glBindVertexArray(0);
-}
\ No newline at end of file
+	//weld the corners that share a position, the collapses work on the welded vertices
+	//while every corner keeps its own color, uv and normal
+	std::map<std::vector<float>, uint> mapWeld;
+	std::vector<uint> lCornerVertex(uTriangleCount * 3);
+	std::vector<vector3> lPosition;
+	for (uint c = 0; c < uTriangleCount * 3; ++c)
+	{
+		std::vector<float> key = { lCorner[c].x, lCorner[c].y, lCorner[c].z };
+		auto it = mapWeld.find(key);
+		if (it == mapWeld.end())
+		{
+			it = mapWeld.insert(std::make_pair(key, static_cast<uint>(lPosition.size()))).first;
+			lPosition.push_back(lCorner[c]);
+		}
+		lCornerVertex[c] = it->second;
+	}
+	uint uVertexCount = lPosition.size();
+
+	//error quadric of each vertex, sum of the planes of its triangles weighted by their area
+	std::vector<glm::dmat4> lQuadric(uVertexCount, glm::dmat4(0.0));
+	std::vector<std::vector<uint>> lVertexTriangle(uVertexCount);
+	std::map<std::pair<uint, uint>, std::vector<uint>> mapEdge; //triangles of each edge
+	std::vector<bool> lAlive(uTriangleCount, true);
+	uint uAlive = uTriangleCount;
+	for (uint t = 0; t < uTriangleCount; ++t)
+	{
+		uint* pVertex = &lCornerVertex[t * 3];
+		//triangles that already lost a corner (poles of a sphere) are dropped right away
+		if (pVertex[0] == pVertex[1] || pVertex[1] == pVertex[2] || pVertex[2] == pVertex[0])
+		{
+			lAlive[t] = false;
+			uAlive--;
+			continue;
+		}
+		glm::dvec3 v3A(lPosition[pVertex[0]]), v3B(lPosition[pVertex[1]]), v3C(lPosition[pVertex[2]]);
+		glm::dvec3 v3Normal = glm::cross(v3B - v3A, v3C - v3A);
+		double dArea = glm::length(v3Normal);
+		for (uint k = 0; k < 3; ++k)
+		{
+			lVertexTriangle[pVertex[k]].push_back(t);
+			uint uFrom = pVertex[k];
+			uint uTo = pVertex[(k + 1) % 3];
+			mapEdge[std::make_pair(glm::min(uFrom, uTo), glm::max(uFrom, uTo))].push_back(t);
+		}
+		if (dArea <= 0.0)
+			continue;
+		v3Normal /= dArea;
+		glm::dvec4 v4Plane(v3Normal, -glm::dot(v3Normal, v3A));
+		glm::dmat4 m4Plane = glm::outerProduct(v4Plane, v4Plane) * (dArea * 0.5);
+		for (uint k = 0; k < 3; ++k)
+			lQuadric[pVertex[k]] += m4Plane;
+	}
+	//open borders get a steep plane along them so the silhouette of open meshes does not shrink
+	for (auto it = mapEdge.begin(); it != mapEdge.end(); ++it)
+	{
+		if (it->second.size() != 1)
+			continue;
+		uint* pVertex = &lCornerVertex[it->second[0] * 3];
+		glm::dvec3 v3A(lPosition[it->first.first]), v3B(lPosition[it->first.second]);
+		glm::dvec3 v3Face = glm::cross(glm::dvec3(lPosition[pVertex[1]]) - glm::dvec3(lPosition[pVertex[0]]),
+			glm::dvec3(lPosition[pVertex[2]]) - glm::dvec3(lPosition[pVertex[0]]));
+		glm::dvec3 v3Normal = glm::cross(v3B - v3A, v3Face);
+		double dLength = glm::length(v3Normal);
+		if (dLength <= 0.0)
+			continue;
+		v3Normal /= dLength;
+		glm::dvec4 v4Plane(v3Normal, -glm::dot(v3Normal, v3A));
+		glm::dmat4 m4Plane = glm::outerProduct(v4Plane, v4Plane) * (glm::distance(v3A, v3B) * 1000.0);
+		lQuadric[it->first.first] += m4Plane;
+		lQuadric[it->first.second] += m4Plane;
+	}
+
+	//candidate collapses in a min heap by error, an entry is stale once either vertex changed
+	struct Collapse
+	{
+		double m_dError; //error of moving both vertices to the target
+		uint m_uKeep; //vertex that stays
+		uint m_uRemove; //vertex that goes away
+		uint m_uKeepStamp; //version of the kept vertex when the entry was made
+		uint m_uRemoveStamp; //version of the removed vertex when the entry was made
+		vector3 m_v3Target; //position of the kept vertex after the collapse
+	};
+	auto HeapOrder = [](Collapse const& a, Collapse const& b) { return a.m_dError > b.m_dError; };
+	std::vector<Collapse> lHeap;
+	std::vector<uint> lStamp(uVertexCount, 0);
+	std::vector<bool> lRemoved(uVertexCount, false);
+	auto PushCollapse = [&](uint a_uA, uint a_uB)
+	{
+		glm::dmat4 m4Quadric = lQuadric[a_uA] + lQuadric[a_uB];
+		vector3 v3Option[3] = { lPosition[a_uA], lPosition[a_uB], (lPosition[a_uA] + lPosition[a_uB]) * 0.5f };
+		Collapse collapse;
+		collapse.m_dError = DBL_MAX;
+		for (uint i = 0; i < 3; ++i)
+		{
+			glm::dvec4 v4Point(v3Option[i].x, v3Option[i].y, v3Option[i].z, 1.0);
+			double dError = glm::dot(v4Point, m4Quadric * v4Point);
+			if (dError < collapse.m_dError)
+			{
+				collapse.m_dError = dError;
+				collapse.m_v3Target = v3Option[i];
+			}
+		}
+		collapse.m_uKeep = a_uA;
+		collapse.m_uRemove = a_uB;
+		collapse.m_uKeepStamp = lStamp[a_uA];
+		collapse.m_uRemoveStamp = lStamp[a_uB];
+		lHeap.push_back(collapse);
+		std::push_heap(lHeap.begin(), lHeap.end(), HeapOrder);
+	};
+	for (auto it = mapEdge.begin(); it != mapEdge.end(); ++it)
+	{
+		if (it->first.first != it->first.second)
+			PushCollapse(it->first.first, it->first.second);
+	}
+
+	std::vector<uint> lNeighbor;
+	while (uAlive > a_uTriangles && !lHeap.empty())
+	{
+		std::pop_heap(lHeap.begin(), lHeap.end(), HeapOrder);
+		Collapse collapse = lHeap.back();
+		lHeap.pop_back();
+		uint uKeep = collapse.m_uKeep;
+		uint uRemove = collapse.m_uRemove;
+		if (lRemoved[uKeep] || lRemoved[uRemove] ||
+			lStamp[uKeep] != collapse.m_uKeepStamp || lStamp[uRemove] != collapse.m_uRemoveStamp)
+			continue;
+
+		//skip the collapse if a surviving triangle around it would flip over
+		bool bFlips = false;
+		for (uint v = 0; v < 2 && !bFlips; ++v)
+		{
+			uint uVertex = v == 0 ? uKeep : uRemove;
+			for (uint t : lVertexTriangle[uVertex])
+			{
+				if (!lAlive[t])
+					continue;
+				uint* pVertex = &lCornerVertex[t * 3];
+				if ((pVertex[0] == uKeep || pVertex[1] == uKeep || pVertex[2] == uKeep) &&
+					(pVertex[0] == uRemove || pVertex[1] == uRemove || pVertex[2] == uRemove))
+					continue;
+				vector3 v3Before[3], v3After[3];
+				for (uint k = 0; k < 3; ++k)
+				{
+					v3Before[k] = lPosition[pVertex[k]];
+					v3After[k] = pVertex[k] == uVertex ? collapse.m_v3Target : v3Before[k];
+				}
+				vector3 v3NormalBefore = glm::cross(v3Before[1] - v3Before[0], v3Before[2] - v3Before[0]);
+				vector3 v3NormalAfter = glm::cross(v3After[1] - v3After[0], v3After[2] - v3After[0]);
+				if (glm::dot(v3NormalBefore, v3NormalAfter) <= 0.0f)
+				{
+					bFlips = true;
+					break;
+				}
+			}
+		}
+		if (bFlips)
+			continue;
+
+		//move the kept vertex, drop the triangles on the edge and hand the rest over
+		lPosition[uKeep] = collapse.m_v3Target;
+		lQuadric[uKeep] += lQuadric[uRemove];
+		lRemoved[uRemove] = true;
+		lStamp[uKeep]++;
+		for (uint t : lVertexTriangle[uRemove])
+		{
+			if (!lAlive[t])
+				continue;
+			uint* pVertex = &lCornerVertex[t * 3];
+			if (pVertex[0] == uKeep || pVertex[1] == uKeep || pVertex[2] == uKeep)
+			{
+				lAlive[t] = false;
+				uAlive--;
+				continue;
+			}
+			for (uint k = 0; k < 3; ++k)
+			{
+				if (pVertex[k] == uRemove)
+					pVertex[k] = uKeep;
+			}
+			lVertexTriangle[uKeep].push_back(t);
+		}
+		lVertexTriangle[uRemove].clear();
+
+		//the edges around the kept vertex have a new cost
+		std::vector<uint>& lTriangle = lVertexTriangle[uKeep];
+		lTriangle.erase(std::remove_if(lTriangle.begin(), lTriangle.end(),
+			[&](uint t) { return !lAlive[t]; }), lTriangle.end());
+		lNeighbor.clear();
+		for (uint t : lTriangle)
+		{
+			for (uint k = 0; k < 3; ++k)
+			{
+				if (lCornerVertex[t * 3 + k] != uKeep)
+					lNeighbor.push_back(lCornerVertex[t * 3 + k]);
+			}
+		}
+		std::sort(lNeighbor.begin(), lNeighbor.end());
+		lNeighbor.erase(std::unique(lNeighbor.begin(), lNeighbor.end()), lNeighbor.end());
+		for (uint uNeighbor : lNeighbor)
+			PushCollapse(uKeep, uNeighbor);
+	}
+
+	//rebuild the corners of the surviving triangles
+	std::vector<vector3>& lColor = pGeometry->m_lVertexCol;
+	std::vector<vector3>& lUV = pGeometry->m_lVertexUV;
+	std::vector<vector3>& lNormal = pGeometry->m_lVertexNor;
+	std::vector<vector3>& lBinormal = pGeometry->m_lVertexBin;
+	std::vector<vector3>& lTangent = pGeometry->m_lVertexTan;
+	for (uint t = 0; t < uTriangleCount; ++t)
+	{
+		if (!lAlive[t])
+			continue;
+		for (uint c = t * 3; c < t * 3 + 3; ++c)
+		{
+			AddVertexPosition(lPosition[lCornerVertex[c]]);
+			AddVertexColor(lColor[c]);
+			AddVertexUV(lUV[c]);
+			AddVertexNormal(lNormal[c]);
+			AddVertexBinormal(lBinormal[c]);
+			AddVertexTangent(lTangent[c]);
+		}
+	}
+
+	m_sName = a_pSource->m_sName + "_LOD" + std::to_string(m_uID);
+	m_uMaterialIndex = a_pSource->m_uMaterialIndex;
+	m_nShader = a_pSource->m_nShader;
+	m_v3Tint = a_pSource->m_v3Tint;
+	m_v3Wireframe = a_pSource->m_v3Wireframe;
+	CompileOpenGL3X();
+}
@@ -37,6 +37,13 @@ void MeshManager::Release(void)
 		}
 	}
 	for (uint i = 0; i < uMeshCount; ++i)
+	{
+		for (uint j = 0; j < m_lodList[i].m_lLevel.size(); ++j)
+			SafeDelete(m_lodList[i].m_lLevel[j]);
+	}
+	m_lodList.clear();
+	m_bucketList.clear();
+	for (uint i = 0; i < uMeshCount; ++i)
 	{
 		std::vector<MeshOptions>* meshOptions = m_renderOptionsList[i];
 		if (meshOptions)
@@ -185,171 +192,38 @@ int MeshManager::InstantiateMesh(uint a_uMeshIndex, String a_sNameNewInstance)
 }
 void MeshManager::AddPlaneToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 5;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "plane_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GeneratePlane(1.0f, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every plane shares the same mesh
+	AddMeshToRenderList(5, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddCubeToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 1;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "cube_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GenerateCube(1.0f, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every cube shares the same mesh
+	AddMeshToRenderList(1, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddConeToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 2;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "cone_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GenerateCone(1.0f, 1.0f, 12, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every cone shares the same mesh
+	AddMeshToRenderList(2, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddCylinderToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 3;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "cylinder_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GenerateCylinder(1.0f, 1.0f, 12, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every cylinder shares the same mesh
+	AddMeshToRenderList(3, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddTubeToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 4;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "tube_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GenerateTube(1.0f, 0.6f, 1.0f, 12, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every tube shares the same mesh
+	AddMeshToRenderList(4, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddTorusToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 7;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "torus_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GenerateTorus(1.0f, 0.6f, 12, 12, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every torus shares the same mesh
+	AddMeshToRenderList(7, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddSphereToRenderList(matrix4 a_m4ToWorld, vector3 a_v3Color, int a_Render)
 {
-	//Get the index based on the name
-	int nMeshIndex = 6;
-	if (a_v3Color != C_WHITE)
-	{
-		//Get the name of the object
-		String sName = "sphere_(" + std::to_string(a_v3Color.x) +
-			"," + std::to_string(a_v3Color.y) +
-			"," + std::to_string(a_v3Color.z) + ")";
-		nMeshIndex = GetMeshIndex(sName);
-		//If the object does not exist create it
-		if (nMeshIndex < 0)
-		{
-			int nIndex = GenerateSphere(1.0f, 6, a_v3Color);
-			if (nIndex < 0) //if I could not make the mesh return
-				return;
-		}
-	}
-	// add an instance of the object to the pile
-	AddMeshToRenderList(nMeshIndex, a_m4ToWorld, a_Render);
-
-	return;
+	//the color travels with the instance, every sphere shares the same mesh
+	AddMeshToRenderList(6, a_m4ToWorld, a_Render, a_v3Color);
 }
 void MeshManager::AddSkyboxToRenderList(String a_sFileName)
 {
@@ -416,7 +290,11 @@ int MeshManager::AddMesh(Mesh* a_pMesh)
 	m_meshList.push_back(a_pMesh);
 	std::vector<MeshOptions>* meshOptions = new std::vector<MeshOptions>();
 	m_renderOptionsList.push_back(meshOptions);
+	m_lodList.push_back(MeshLOD());
 	m_meshNames[a_pMesh->GetName()] = m_meshList.size() - 1;
+	//compiled meshes get their levels now, the rest the first time they are rendered
+	if (a_pMesh->GetBinded())
+		GenerateLOD(m_meshList.size() - 1);
 	return m_meshList.size() - 1;
 }
 Mesh* MeshManager::GetMesh(String a_sName)
@@ -438,8 +316,7 @@ void MeshManager::SetRenderTarget(GLuint a_uFrameBuffer, GLuint a_uDepthBuffer,
 	glBindFramebuffer(GL_FRAMEBUFFER, a_uFrameBuffer);
 
 	//Texture to render to
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, a_uTextureToRender);
+	GLStateManager::GetInstance()->BindTexture(0, a_uTextureToRender, true);
 
 	glBindRenderbuffer(GL_RENDERBUFFER, a_uDepthBuffer);
 
@@ -453,7 +330,7 @@ void MeshManager::SetRenderTarget(GLuint a_uFrameBuffer, GLuint a_uDepthBuffer,
 	if (nHeight < 0)
 		nHeight = pSystem->GetWindowHeight();
 
-	glViewport(static_cast<GLint>(0),
+	GLStateManager::GetInstance()->SetViewport(static_cast<GLint>(0),
 		static_cast<GLint>(0),
 		static_cast<GLint>(nWidth),
 		static_cast<GLint>(nHeight));
@@ -482,14 +359,14 @@ void MeshManager::CompileMesh(uint a_nMeshIndex)
 		return;
 	m_meshList[a_nMeshIndex]->CompileOpenGL3X();
 }
-void MeshManager::AddMeshToRenderList(uint a_nIndex, matrix4 a_m4Transform, int a_Render)
+void MeshManager::AddMeshToRenderList(uint a_nIndex, matrix4 a_m4Transform, int a_Render, vector3 a_v3Color)
 {
 	//Id the index is larger than the number of meshes we know about return
 	if (a_nIndex >= m_meshList.size())
 		return;
 
 	//we create a new options object and store the information provided
-	MeshOptions options(a_m4Transform, a_Render);
+	MeshOptions options(a_m4Transform, a_Render, a_v3Color);
 
 	//Get the list of options for this mesh
 	//std::vector<MeshOptions>* optionsList = m_MeshOptionsList[a_nIndex];
@@ -513,19 +390,19 @@ void MeshManager::AddMeshToRenderList(uint a_nIndex, matrix4 a_m4Transform, int
 	m_mRender[a_sMeshName] = lOptions;
 	*/
 }
-void MeshManager::AddMeshToRenderList(String a_sMeshName, matrix4 a_m4Transform, int a_Render)
+void MeshManager::AddMeshToRenderList(String a_sMeshName, matrix4 a_m4Transform, int a_Render, vector3 a_v3Color)
 {
 	int nMeshIndex = GetMeshIndex(a_sMeshName);
 	if (nMeshIndex < 0)
 		return;
 
-	AddMeshToRenderList(nMeshIndex, a_m4Transform, a_Render);
+	AddMeshToRenderList(nMeshIndex, a_m4Transform, a_Render, a_v3Color);
 }
-void MeshManager::AddMeshToRenderList(Mesh* a_pMesh, matrix4 a_m4Transform, int a_Render)
+void MeshManager::AddMeshToRenderList(Mesh* a_pMesh, matrix4 a_m4Transform, int a_Render, vector3 a_v3Color)
 {
 	if (!a_pMesh)
 		return;
-	AddMeshToRenderList(a_pMesh->GetName(), a_m4Transform, a_Render);
+	AddMeshToRenderList(a_pMesh->GetName(), a_m4Transform, a_Render, a_v3Color);
 
 	/*
 	//we create a new options object and store the information provided
@@ -554,104 +431,182 @@ void MeshManager::AddMeshToRenderList(Mesh* a_pMesh, matrix4 a_m4Transform, int
 }
 uint MeshManager::Render(void)
 {
-	//for each element in map check the rendering type
+	//a new frame starts, keep the state call counts of the last one
+	GLStateManager::GetInstance()->ResetCounters();
+	//pick up the shaders that changed on disk
+	m_pShaderMngr->Update();
+	//upload the textures that finished decoding in the background
+	TextureManager::GetInstance()->Update();
+
+	matrix4 m4Projection = m_pCameraMngr->GetProjectionMatrix();
+	matrix4 m4View = m_pCameraMngr->GetViewMatrix();
+	m_uTriangleCount = 0;
+	m_uFullTriangleCount = 0;
+
+	//for each mesh sort its instances by level and render mode, every bucket is one render call
 	uint nMeshCount = m_meshList.size();
-	std::vector<matrix4> solidList;
-	std::vector<matrix4> wireList;
-	std::vector<matrix4> bothList;
 	std::vector<MeshOptions>* optionList;
 	for (uint nMesh = 0; nMesh < nMeshCount; ++nMesh)
 	{
 		optionList = m_renderOptionsList[nMesh];
-		if (optionList->size() > 0)
+		uint uOptions = optionList->size();
+		if (uOptions == 0)
+			continue;
+
+		MeshLOD& lod = m_lodList[nMesh];
+		if (!lod.m_bBuilt && m_meshList[nMesh]->GetBinded())
+			GenerateLOD(nMesh);
+		uint uLevels = m_bLOD ? lod.m_lLevel.size() + 1 : 1;
+		if (m_bucketList.size() < uLevels * 3)
+			m_bucketList.resize(uLevels * 3);
+		//instances are matched to last frame by their position in the render list
+		lod.m_lChoice.resize(uOptions, static_cast<uint>(-1));
+
+		for (uint nOpt = 0; nOpt < uOptions; ++nOpt)
 		{
-			//The idea is to know what each mesh will be rendered as and store the matrix in a list
-			//that way we will have 3 separate calls each for a render mode
-			for (uint nOpt = 0; nOpt < optionList->size(); ++nOpt)
-			{
-				switch ((*optionList)[nOpt].m_nRender)
-				{
-				case RENDER_NONE:
-					break;
-				case RENDER_SOLID:
-					solidList.push_back((*optionList)[nOpt].m_m4Transform);
-					break;
-				case RENDER_WIRE:
-					wireList.push_back((*optionList)[nOpt].m_m4Transform);
-					break;
-				default:
-					bothList.push_back((*optionList)[nOpt].m_m4Transform);
-					break;
-				}
-			}
-			//For Solids ---------------------------------------------------------------------------
-			int nSolids = solidList.size();//count elements
-			if (nSolids > 0)
-			{
-				float* fSolidArray = new float[16 * nSolids];//reserve memory
-															 //memcpy the translated values to the array (way faster than copy element by element)
-				for (int nSolid = 0; nSolid < nSolids; ++nSolid)
-				{
-					const float* m4MVP = glm::value_ptr(solidList[nSolid]);
-					memcpy(&fSolidArray[nSolid * 16], m4MVP, 16 * sizeof(float));
-				}
-				//render
-				m_meshList[nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
-					fSolidArray, solidList.size(), m_pCameraMngr->GetPosition(), RENDER_SOLID);
-				//deallocate memory
-				if (fSolidArray)
-				{
-					delete[] fSolidArray;
-					fSolidArray = nullptr;
-				}
-				solidList.clear();
-			}
-			//For Wires ---------------------------------------------------------------------------
-			int nWires = wireList.size();//count elements
-			if (nWires > 0)
+			MeshOptions& options = (*optionList)[nOpt];
+			uint uMode;
+			switch (options.m_nRender)
 			{
-				float* fWireArray = new float[16 * nWires];//reserve memory
-														   //memcpy the translated values to the array (way faster than copy element by element)
-				for (int nWire = 0; nWire < nWires; ++nWire)
-				{
-					const float* m4MVP = glm::value_ptr(wireList[nWire]);
-					memcpy(&fWireArray[nWire * 16], m4MVP, 16 * sizeof(float));
-				}
-				//render
-				m_meshList[nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
-					fWireArray, wireList.size(), m_pCameraMngr->GetPosition(), RENDER_WIRE);
-				//deallocate memory
-				if (fWireArray)
-				{
-					delete[] fWireArray;
-					fWireArray = nullptr;
-				}
-				wireList.clear();
+			case RENDER_NONE:
+				continue;
+			case RENDER_SOLID:
+				uMode = 0;
+				break;
+			case RENDER_WIRE:
+				uMode = 1;
+				break;
+			default:
+				uMode = 2;
+				break;
 			}
-			//For Both ---------------------------------------------------------------------------
-			int nBoths = bothList.size();//count elements
-			if (nBoths > 0)
+			uint uLevel = uLevels > 1 ? PickLOD(lod, nOpt, options.m_m4Transform, m4View, m4Projection) : 0;
+			//the colors are only sent if at least one instance of the call is not white
+			InstanceBucket& bucket = m_bucketList[uLevel * 3 + uMode];
+			bucket.m_lTransform.push_back(options.m_m4Transform);
+			bucket.m_lColor.push_back(options.m_v3Color);
+			bucket.m_bColor = bucket.m_bColor || options.m_v3Color != C_WHITE;
+		}
+
+		uint uFullTriangles = m_meshList[nMesh]->GetVertexCount() / 3;
+		for (uint uLevel = 0; uLevel < uLevels; ++uLevel)
+		{
+			Mesh* pMesh = uLevel == 0 ? m_meshList[nMesh] : lod.m_lLevel[uLevel - 1];
+			uint uTriangles = pMesh->GetVertexCount() / 3;
+			for (uint uMode = 0; uMode < 3; ++uMode)
 			{
-				float* fBothArray = new float[16 * nBoths];//reserve memory
-														   //memcpy the translated values to the array (way faster than copy element by element)
-				for (int nBoth = 0; nBoth < nBoths; ++nBoth)
-				{
-					const float* m4MVP = glm::value_ptr(bothList[nBoth]);
-					memcpy(&fBothArray[nBoth * 16], m4MVP, 16 * sizeof(float));
-				}
-				//render
-				m_meshList[nMesh]->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
-					fBothArray, bothList.size(), m_pCameraMngr->GetPosition(), RENDER_SOLID | RENDER_WIRE);
-				//deallocate memory
-				if (fBothArray)
-				{
-					delete[] fBothArray;
-					fBothArray = nullptr;
-				}
-				bothList.clear();
+				InstanceBucket& bucket = m_bucketList[uLevel * 3 + uMode];
+				uint uInstances = bucket.m_lTransform.size();
+				if (uInstances == 0)
+					continue;
+				m_uTriangleCount += uTriangles * uInstances;
+				m_uFullTriangleCount += uFullTriangles * uInstances;
+				int nRender = uMode == 0 ? RENDER_SOLID : uMode == 1 ? RENDER_WIRE : RENDER_SOLID | RENDER_WIRE;
+				RenderBucket(pMesh, bucket, nRender);
 			}
 		}
 	}
 	m_pText->Render();
 	return Mesh::GetRenderCallCount();
-}
\ No newline at end of file
+}
+void MeshManager::RenderBucket(Mesh* a_pMesh, InstanceBucket& a_bucket, int a_nRender)
+{
+	//matrices and colors are contiguous in their lists, no need to copy them to a separate array
+	a_pMesh->Render(m_pCameraMngr->GetProjectionMatrix(), m_pCameraMngr->GetViewMatrix(),
+		glm::value_ptr(a_bucket.m_lTransform[0]), a_bucket.m_lTransform.size(), m_pCameraMngr->GetPosition(), a_nRender,
+		a_bucket.m_bColor ? glm::value_ptr(a_bucket.m_lColor[0]) : nullptr);
+	a_bucket.m_lTransform.clear();
+	a_bucket.m_lColor.clear();
+	a_bucket.m_bColor = false;
+}
+//--- Level of Detail
+uint MeshManager::GenerateLOD(uint a_uMeshIndex)
+{
+	if (a_uMeshIndex >= m_meshList.size())
+		return 0;
+
+	MeshLOD& lod = m_lodList[a_uMeshIndex];
+	for (uint i = 0; i < lod.m_lLevel.size(); ++i)
+		SafeDelete(lod.m_lLevel[i]);
+	lod.m_lLevel.clear();
+	lod.m_lChoice.clear();
+	lod.m_bBuilt = true;
+
+	Mesh* pMesh = m_meshList[a_uMeshIndex];
+	pMesh->GetBoundingSphere(lod.m_v3Center, lod.m_fRadius);
+	uint uTriangles = pMesh->GetVertexCount() / 3;
+	if (uTriangles < m_uLODMinTriangles)
+		return 0;
+
+	//every level aims for half the triangles of the previous one, all simplified from the full mesh
+	uint uPrevious = uTriangles;
+	for (uint i = 0; i < m_uLODLevels; ++i)
+	{
+		Mesh* pLevel = new Mesh();
+		pLevel->GenerateSimplified(pMesh, uPrevious / 2);
+		uint uLevelTriangles = pLevel->GetVertexCount() / 3;
+		//stop once the simplification cannot take the mesh much further
+		if (!pLevel->GetBinded() || uLevelTriangles * 4 > uPrevious * 3)
+		{
+			SafeDelete(pLevel);
+			break;
+		}
+		lod.m_lLevel.push_back(pLevel);
+		uPrevious = uLevelTriangles;
+	}
+	return lod.m_lLevel.size();
+}
+uint MeshManager::PickLOD(MeshLOD& a_lod, uint a_uInstance, matrix4 const& a_m4Transform, matrix4 const& a_m4View, matrix4 const& a_m4Projection)
+{
+	//size of the bounding sphere over the height of the screen, the projection holds the field of view
+	vector4 v4Center = a_m4View * a_m4Transform * vector4(a_lod.m_v3Center, 1.0f);
+	float fW = a_m4Projection[2][3] * v4Center.z + a_m4Projection[3][3];
+	float fScale = glm::max(glm::max(glm::length(vector3(a_m4Transform[0])), glm::length(vector3(a_m4Transform[1]))),
+		glm::length(vector3(a_m4Transform[2])));
+	float fRadius = a_lod.m_fRadius * fScale;
+	if (fW <= fRadius)
+	{
+		a_lod.m_lChoice[a_uInstance] = 0;
+		return 0;
+	}
+	float fSize = fRadius * a_m4Projection[1][1] / fW;
+
+	//level for a size, the first threshold is the screen size and each next one is half the previous
+	uint uLevels = a_lod.m_lLevel.size();
+	auto LevelForSize = [&](float a_fSize) -> uint
+	{
+		if (a_fSize >= m_fLODScreenSize)
+			return 0;
+		uint uLevel = 1;
+		float fThreshold = m_fLODScreenSize * 0.5f;
+		while (uLevel < uLevels && a_fSize < fThreshold)
+		{
+			uLevel++;
+			fThreshold *= 0.5f;
+		}
+		return uLevel;
+	};
+
+	uint& uChoice = a_lod.m_lChoice[a_uInstance];
+	if (uChoice > uLevels)
+	{
+		uChoice = LevelForSize(fSize);
+		return uChoice;
+	}
+	//coarser only once below the threshold by the hysteresis, finer only once above it
+	uint uCoarser = LevelForSize(fSize / (1.0f - m_fLODHysteresis));
+	uint uFiner = LevelForSize(fSize / (1.0f + m_fLODHysteresis));
+	if (uCoarser > uChoice)
+		uChoice = uCoarser;
+	else if (uFiner < uChoice)
+		uChoice = uFiner;
+	return uChoice;
+}
+void MeshManager::SetLOD(bool a_bEnabled, float a_fScreenSize, float a_fHysteresis)
+{
+	m_bLOD = a_bEnabled;
+	m_fLODScreenSize = a_fScreenSize;
+	m_fLODHysteresis = glm::clamp(a_fHysteresis, 0.0f, 0.9f);
+}
+uint MeshManager::GetTriangleCount(void) { return m_uTriangleCount; }
+uint MeshManager::GetFullTriangleCount(void) { return m_uFullTriangleCount; }
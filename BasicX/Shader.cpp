@@ -1,4 +1,6 @@
 #include "BasicX\System\Shader.h"
+#include "BasicX\System\FileReader.h"
+#include "BasicX\System\GLStateManager.h"
 using namespace BasicX;
 void Shader::Init(void)
 {
@@ -23,6 +25,7 @@ void Shader::Release(void)
 {
 	if(m_nProgram >= 0 )
 	{
+		GLStateManager::GetInstance()->ForgetProgram(m_nProgram);
 		glDeleteProgram(m_nProgram);
 		m_nProgram = -1;
 	}
@@ -61,10 +64,57 @@ GLuint Shader::CompileShader(String a_sVertexShader, String a_sFragmentShader, S
 	
 	m_sVertexShaderName = a_sVertexShader;
 	m_sFragmentShaderName = a_sFragmentShader;
-	m_nProgram = LoadShaders( m_sVertexShaderName.c_str(), m_sFragmentShaderName.c_str() );
+	m_nProgram = 0;
+
+	String sVertex;
+	String sFragment;
+	if (!ReadShaderFile(m_sVertexShaderName.c_str(), sVertex) || !ReadShaderFile(m_sFragmentShaderName.c_str(), sFragment))
+	{
+		printf("Impossible to open %s or %s.\n", m_sVertexShaderName.c_str(), m_sFragmentShaderName.c_str());
+		return m_nProgram;
+	}
+
+	//if the code and the driver are the same as last run skip the compilation
+	unsigned long long uHash = HashShaderSource(sVertex, sFragment);
+	String sBinary = GetBinaryFileName();
+	m_nProgram = LoadProgramBinary(sBinary.c_str(), uHash);
+	if (m_nProgram == 0)
+	{
+		m_nProgram = CompileProgram(sVertex, sFragment, m_sVertexShaderName.c_str(), m_sFragmentShaderName.c_str());
+		if (m_nProgram != 0)
+			SaveProgramBinary(m_nProgram, sBinary.c_str(), uHash);
+	}
 
 	return m_nProgram;
 }
+bool Shader::Reload(void)
+{
+	String sVertex;
+	String sFragment;
+	if (!ReadShaderFile(m_sVertexShaderName.c_str(), sVertex) || !ReadShaderFile(m_sFragmentShaderName.c_str(), sFragment))
+		return false;
+
+	//relinking keeps the identifier so meshes holding it pick up the new code
+	GLuint nProgram = CompileProgram(sVertex, sFragment, m_sVertexShaderName.c_str(), m_sFragmentShaderName.c_str(),
+		m_nProgram);
+	if (nProgram == 0)
+		return false;
+	m_nProgram = nProgram;
+
+	SaveProgramBinary(m_nProgram, GetBinaryFileName().c_str(), HashShaderSource(sVertex, sFragment));
+	return true;
+}
+String Shader::GetBinaryFileName(void)
+{
+	//folder of the fragment shader, both separators so it works outside of windows
+	size_t uSlash = m_sFragmentShaderName.find_last_of("\\/");
+	String sFolder = "";
+	if (uSlash != String::npos)
+		sFolder = m_sFragmentShaderName.substr(0, uSlash + 1);
+	//the same vertex shader is shared by several programs, both names make it unique
+	return sFolder + FileReader::GetFileName(FileReader::GetFileNameAndExtension(m_sVertexShaderName)) + "_" +
+		FileReader::GetFileName(FileReader::GetFileNameAndExtension(m_sFragmentShaderName)) + ".bin";
+}
 
 //Attributes
 String Shader::GetProgramName() { return m_sProgramName; }
@@ -15,21 +15,9 @@ typedef std::string String;
 
 GLuint LoadShaders( const char * vertex_file_path, const char * fragment_file_path)
 {
-	// Create the shaders
-	GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-	GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
-	
 	// Read the Vertex Shader code from the file
 	String VertexShaderCode;
-	std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
-	if(VertexShaderStream.is_open())
-	{
-		String Line = "";
-		while(getline(VertexShaderStream, Line))
-			VertexShaderCode += "\n" + Line;
-		VertexShaderStream.close();
-	}
-	else
+	if(!ReadShaderFile(vertex_file_path, VertexShaderCode))
 	{
 		printf("Impossible to open %s. Are you in the right directory?\n", vertex_file_path);
 		getchar();
@@ -38,70 +26,190 @@ GLuint LoadShaders( const char * vertex_file_path, const char * fragment_file_pa
 
 	// Read the Fragment Shader code from the file
 	String FragmentShaderCode;
-	std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
-	if(FragmentShaderStream.is_open())
-	{
-		String Line = "";
-		while(getline(FragmentShaderStream, Line))
-			FragmentShaderCode += "\n" + Line;
-		FragmentShaderStream.close();
-	}
-	
+	ReadShaderFile(fragment_file_path, FragmentShaderCode);
+
+	return CompileProgram(VertexShaderCode, FragmentShaderCode, vertex_file_path, fragment_file_path);
+}
+bool ReadShaderFile(const char * file_path, String& code)
+{
+	std::ifstream ShaderStream(file_path, std::ios::in | std::ios::binary);
+	if(!ShaderStream.is_open())
+		return false;
+
+	//read it in one go instead of line by line
+	ShaderStream.seekg(0, std::ios::end);
+	code.resize(static_cast<size_t>(ShaderStream.tellg()));
+	ShaderStream.seekg(0, std::ios::beg);
+	if(code.size() > 0)
+		ShaderStream.read(&code[0], code.size());
+	ShaderStream.close();
+	return true;
+}
+//Compiles one stage, only prints when the compiler has something to say
+static GLuint CompileStage(GLenum type, const String& code, const char * file_path)
+{
+	GLuint ShaderID = glCreateShader(type);
+	char const * SourcePointer = code.c_str();
+	glShaderSource(ShaderID, 1, &SourcePointer , NULL);
+	glCompileShader(ShaderID);
+
 	GLint Result = GL_FALSE;
 	int InfoLogLength;
-	
-	// Compile Vertex Shader
-	printf("	Vertex: %s", vertex_file_path);
-	char const * VertexSourcePointer = VertexShaderCode.c_str();
-	glShaderSource(VertexShaderID, 1, &VertexSourcePointer , NULL);
-	glCompileShader(VertexShaderID);
-
-	// Check Vertex Shader
-	glGetShaderiv(VertexShaderID, GL_COMPILE_STATUS, &Result);
-	glGetShaderiv(VertexShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-	if ( InfoLogLength > 0 )
+	glGetShaderiv(ShaderID, GL_COMPILE_STATUS, &Result);
+	glGetShaderiv(ShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
+	if ( InfoLogLength > 1 )
 	{
-		std::vector<char> VertexShaderErrorMessage(InfoLogLength+1);
-		glGetShaderInfoLog(VertexShaderID, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
-		printf("%s", &VertexShaderErrorMessage[0]);
+		std::vector<char> ShaderErrorMessage(InfoLogLength+1);
+		glGetShaderInfoLog(ShaderID, InfoLogLength, NULL, &ShaderErrorMessage[0]);
+		printf("%s:\n%s\n", file_path, &ShaderErrorMessage[0]);
+	}
+	if ( Result == GL_FALSE )
+	{
+		glDeleteShader(ShaderID);
+		return 0;
 	}
-	
-	printf("\n");
-	// Compile Fragment Shader
-	printf("	Fragment: %s", fragment_file_path);
-	char const * FragmentSourcePointer = FragmentShaderCode.c_str();
-	glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer , NULL);
-	glCompileShader(FragmentShaderID);
-	
-	// Check Fragment Shader
-	glGetShaderiv(FragmentShaderID, GL_COMPILE_STATUS, &Result);
-	glGetShaderiv(FragmentShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-	if ( InfoLogLength > 0 )
+	return ShaderID;
+}
+GLuint CompileProgram(const String& vertex_code, const String& fragment_code,
+	const char * vertex_file_path, const char * fragment_file_path, GLuint target_program)
+{
+	GLuint VertexShaderID = CompileStage(GL_VERTEX_SHADER, vertex_code, vertex_file_path);
+	GLuint FragmentShaderID = CompileStage(GL_FRAGMENT_SHADER, fragment_code, fragment_file_path);
+	if(VertexShaderID == 0 || FragmentShaderID == 0)
 	{
-		std::vector<char> FragmentShaderErrorMessage(InfoLogLength+1);
-		glGetShaderInfoLog(FragmentShaderID, InfoLogLength, NULL, &FragmentShaderErrorMessage[0]);
-		printf("%s", &FragmentShaderErrorMessage[0]);
+		glDeleteShader(VertexShaderID);
+		glDeleteShader(FragmentShaderID);
+		return 0;
 	}
 
-	//Link the program
+	//Link the program, asking the driver to keep the binary around for the cache
 	GLuint ProgramID = glCreateProgram();
+	glProgramParameteri(ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glAttachShader(ProgramID, VertexShaderID);
 	glAttachShader(ProgramID, FragmentShaderID);
 	glLinkProgram(ProgramID);
-	printf("\n	Program linked.\n");
-	
+
 	// Check the program
+	GLint Result = GL_FALSE;
+	int InfoLogLength;
 	glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
 	glGetProgramiv(ProgramID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-	if ( InfoLogLength > 0 )
+	if ( InfoLogLength > 1 )
 	{
 		std::vector<char> ProgramErrorMessage(InfoLogLength+1);
 		glGetProgramInfoLog(ProgramID, InfoLogLength, NULL, &ProgramErrorMessage[0]);
-		printf("%s\n", &ProgramErrorMessage[0]);
-	}	
+		printf("%s + %s:\n%s\n", vertex_file_path, fragment_file_path, &ProgramErrorMessage[0]);
+	}
+
+	//the new code links, so the target can take it without ever being left broken
+	if ( Result != GL_FALSE && target_program != 0 )
+	{
+		glDeleteProgram(ProgramID);
+		ProgramID = target_program;
+		glProgramParameteri(ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glAttachShader(ProgramID, VertexShaderID);
+		glAttachShader(ProgramID, FragmentShaderID);
+		glLinkProgram(ProgramID);
+		glDetachShader(ProgramID, VertexShaderID);
+		glDetachShader(ProgramID, FragmentShaderID);
+	}
 
 	glDeleteShader(VertexShaderID);
 	glDeleteShader(FragmentShaderID);
-	
+
+	if ( Result == GL_FALSE )
+	{
+		glDeleteProgram(ProgramID);
+		return 0;
+	}
+	return ProgramID;
+}
+unsigned long long HashShaderSource(const String& vertex_code, const String& fragment_code)
+{
+	//FNV-1a over the code and the driver, a binary from another driver is useless
+	const char* Driver[3] = {
+		(const char*)glGetString(GL_VENDOR),
+		(const char*)glGetString(GL_RENDERER),
+		(const char*)glGetString(GL_VERSION) };
+	unsigned long long Hash = 14695981039346656037ULL;
+	auto Add = [&Hash](const char* data, size_t size)
+	{
+		for(size_t i = 0; i < size; i++)
+		{
+			Hash ^= static_cast<unsigned char>(data[i]);
+			Hash *= 1099511628211ULL;
+		}
+		Hash ^= 0xFF; //separator, so moving text between the strings changes the hash
+		Hash *= 1099511628211ULL;
+	};
+	Add(vertex_code.c_str(), vertex_code.size());
+	Add(fragment_code.c_str(), fragment_code.size());
+	for(int i = 0; i < 3; i++)
+	{
+		if(Driver[i] != nullptr)
+			Add(Driver[i], strlen(Driver[i]));
+	}
+	return Hash;
+}
+GLuint LoadProgramBinary(const char * binary_file_path, unsigned long long source_hash)
+{
+	std::ifstream BinaryStream(binary_file_path, std::ios::in | std::ios::binary);
+	if(!BinaryStream.is_open())
+		return 0;
+
+	//header: hash of the code, binary format and binary length
+	unsigned long long Hash = 0;
+	GLenum Format = 0;
+	GLint Length = 0;
+	BinaryStream.read((char*)&Hash, sizeof(Hash));
+	BinaryStream.read((char*)&Format, sizeof(Format));
+	BinaryStream.read((char*)&Length, sizeof(Length));
+	if(!BinaryStream || Hash != source_hash || Length <= 0)
+		return 0;
+
+	std::vector<char> Binary(Length);
+	BinaryStream.read(&Binary[0], Length);
+	if(!BinaryStream)
+		return 0;
+	BinaryStream.close();
+
+	GLuint ProgramID = glCreateProgram();
+	glProgramBinary(ProgramID, Format, &Binary[0], Length);
+
+	//the driver can refuse a binary (updated driver, different GPU), then we compile
+	GLint Result = GL_FALSE;
+	glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
+	if(Result == GL_FALSE)
+	{
+		glDeleteProgram(ProgramID);
+		return 0;
+	}
 	return ProgramID;
+}
+bool SaveProgramBinary(GLuint program, const char * binary_file_path, unsigned long long source_hash)
+{
+	GLint Formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &Formats);
+	if(Formats <= 0)
+		return false;
+
+	GLint Length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &Length);
+	if(Length <= 0)
+		return false;
+
+	std::vector<char> Binary(Length);
+	GLenum Format = 0;
+	glGetProgramBinary(program, Length, &Length, &Format, &Binary[0]);
+	if(Length <= 0)
+		return false;
+
+	std::ofstream BinaryStream(binary_file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!BinaryStream.is_open())
+		return false;
+	BinaryStream.write((const char*)&source_hash, sizeof(source_hash));
+	BinaryStream.write((const char*)&Format, sizeof(Format));
+	BinaryStream.write((const char*)&Length, sizeof(Length));
+	BinaryStream.write(&Binary[0], Length);
+	return static_cast<bool>(BinaryStream);
 }
\ No newline at end of file
@@ -1,5 +1,14 @@
 #include "BasicX\System\ShaderManager.h"
+#include <sys/stat.h>
 using namespace BasicX;
+//Last time the file was modified, 0 if it does not exist
+static time_t GetModifiedTime(String const& a_sFile)
+{
+	struct stat oStat;
+	if (stat(a_sFile.c_str(), &oStat) != 0)
+		return 0;
+	return oStat.st_mtime;
+}
 //  ShaderManager
 ShaderManager* ShaderManager::m_pInstance = nullptr;
 void ShaderManager::Init(void)
@@ -10,8 +19,8 @@ void ShaderManager::Init(void)
 	//Compile Color shader
 	Folder* pFolder = Folder::GetInstance();
 
-	//Compile Text shader
-	CompileShader(pFolder->GetFolderShaders() + "Text.vs", pFolder->GetFolderShaders() + "Text.fs", "Text");
+	//Compile Text shader, the BasicX vertex shader reads the interleaved text vertices
+	CompileShader(pFolder->GetFolderShaders() + "BasicXText.vs", pFolder->GetFolderShaders() + "Text.fs", "Text");
 
 	//Compile Basic shader
 	CompileShader(pFolder->GetFolderShaders() + "Basic.vs", pFolder->GetFolderShaders() + "Basic.fs", "Basic");
@@ -19,16 +28,17 @@ void ShaderManager::Init(void)
 	//Compile Skybox shader
 	CompileShader(pFolder->GetFolderShaders() + "Skybox.vs", pFolder->GetFolderShaders() + "Skybox.fs", "Skybox");
 
+	//the BasicX files read the color of each instance, the Simplex files of the same name do not
 	//Compile Wireframe shader
-	CompileShader(pFolder->GetFolderShaders() + "Simplex.vs", pFolder->GetFolderShaders() + "Wireframe.fs", "Wireframe");
+	CompileShader(pFolder->GetFolderShaders() + "BasicXSimplex.vs", pFolder->GetFolderShaders() + "BasicXWireframe.fs", "Wireframe");
 
 	//Compile Simplex shader
-	CompileShader(pFolder->GetFolderShaders() + "Simplex.vs", pFolder->GetFolderShaders() + "Simplex.fs", "Simplex");
-
-	printf("\n");
+	CompileShader(pFolder->GetFolderShaders() + "BasicXSimplex.vs", pFolder->GetFolderShaders() + "Simplex.fs", "Simplex");
 }
 void ShaderManager::Release(void)
 {
+	SetHotReload(false);
+
 	int nShaders = static_cast<int>(m_vShader.size());
 	for(int nShader = 0; nShader < nShaders; nShader++)
 	{
@@ -36,6 +46,8 @@ void ShaderManager::Release(void)
 	}
 
 	m_vShader.clear();
+	m_watchList.clear();
+	m_changedSet.clear();
 }
 ShaderManager* ShaderManager::GetInstance()
 {
@@ -66,12 +78,19 @@ GLuint ShaderManager::CompileShader(String a_sVertexShader, String a_sFragmentSh
 		return nShader;
 
 	Shader vShader;
-	printf("Compiling shader: %s\n", a_sName.c_str());
 	nShader = vShader.CompileShader(a_sVertexShader, a_sFragmentShader, a_sName);
 	m_vShader.push_back(vShader);
 	m_map[vShader.GetProgramName()] = m_uShaderCount;
 	m_uShaderCount++;
 
+	ShaderFiles oFiles;
+	oFiles.m_sVertex = a_sVertexShader;
+	oFiles.m_sFragment = a_sFragmentShader;
+	oFiles.m_tVertex = GetModifiedTime(a_sVertexShader);
+	oFiles.m_tFragment = GetModifiedTime(a_sFragmentShader);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_watchList.push_back(oFiles);
+
 	return nShader;
 }
 int ShaderManager::IdentifyShader(String a_sName)
@@ -96,4 +115,73 @@ GLuint ShaderManager::GetShaderID(uint a_uIndex)
 		return 0;
 
 	return m_vShader[a_uIndex].GetProgramID();
+}
+uint ShaderManager::GetReloadCount(void) { return m_uReloadCount; }
+bool ShaderManager::IsHotReload(void) { return m_bWatching; }
+void ShaderManager::SetHotReload(bool a_bHotReload)
+{
+	if (a_bHotReload == m_bWatching)
+		return;
+
+	if (a_bHotReload)
+	{
+		m_bStopWatcher = false;
+		m_watcher = std::thread(&ShaderManager::WatchFiles, this);
+		m_bWatching = true;
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopWatcher = true;
+	}
+	m_condition.notify_all();
+	m_watcher.join();
+	m_bWatching = false;
+}
+uint ShaderManager::Update(void)
+{
+	std::set<uint> changedSet;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_changedSet.empty())
+			return 0;
+		std::swap(changedSet, m_changedSet);
+	}
+
+	uint uReloaded = 0;
+	for (uint uShader : changedSet)
+	{
+		if (m_vShader[uShader].Reload())
+		{
+			++m_uReloadCount;
+			++uReloaded;
+		}
+	}
+	return uReloaded;
+}
+void ShaderManager::WatchFiles(void)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_bStopWatcher)
+	{
+		//half a second is quick enough for someone saving a file in an editor
+		m_condition.wait_for(lock, std::chrono::milliseconds(500));
+		if (m_bStopWatcher)
+			return;
+
+		uint uShaders = static_cast<uint>(m_watchList.size());
+		for (uint uShader = 0; uShader < uShaders; ++uShader)
+		{
+			ShaderFiles& oFiles = m_watchList[uShader];
+			time_t tVertex = GetModifiedTime(oFiles.m_sVertex);
+			time_t tFragment = GetModifiedTime(oFiles.m_sFragment);
+			if (tVertex != oFiles.m_tVertex || tFragment != oFiles.m_tFragment)
+			{
+				oFiles.m_tVertex = tVertex;
+				oFiles.m_tFragment = tFragment;
+				m_changedSet.insert(uShader);
+			}
+		}
+	}
 }
\ No newline at end of file
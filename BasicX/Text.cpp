@@ -6,11 +6,11 @@ Text* Text::m_pInstance = nullptr;
 void Text::Init(void)
 {
 	m_sText = "";
-	m_sTextPrev = "";
 	m_sFont;
 
 	m_bBinded = false;
 	m_uVertexCount = 0;
+	m_uBufferCapacity = 0;
 	m_uMaterialIndex = -1;
 
 	m_vao = 0;
@@ -22,10 +22,18 @@ void Text::Init(void)
 	m_pMatMngr = MaterialManager::GetInstance();
 	m_pShaderMngr = ShaderManager::GetInstance();
 	m_nShader = m_pShaderMngr->GetShaderID("Text");//Compile Text shader
+	FindUniforms();
 	m_v3Head = ZERO_V3;
 	SetFont("Font.png");	
 	CompileOpenGL3X();
 }
+void Text::FindUniforms(void)
+{
+	//the locations only change when the shader is relinked
+	m_uShaderReload = m_pShaderMngr->GetReloadCount();
+	m_nMVP = glGetUniformLocation(m_nShader, "MVP");
+	m_nTextureID = glGetUniformLocation(m_nShader, "TextureID");
+}
 void Text::Release(void)
 {
 	m_pMatMngr = nullptr;
@@ -35,11 +43,14 @@ void Text::Release(void)
 		glDeleteBuffers(1, &m_VBO);
 
 	if (m_vao > 0)
+	{
+		GLStateManager::GetInstance()->ForgetVertexArray(m_vao);
 		glDeleteVertexArrays(1, &m_vao);
+	}
 
-	m_lVertexPos.clear();
-	m_lVertexCol.clear();
-	m_lVertexUV.clear();
+	m_lVertex.clear();
+	m_lGlyph.clear();
+	m_lLine.clear();
 }
 void Text::SetFont(String a_sTextureName)
 {
@@ -52,7 +63,7 @@ void Text::SetFont(String a_sTextureName)
 	if (nMaterials != m_pMatMngr->GetMaterialCount())
 	{
 		m_pMatMngr->m_materialList[nMaterial]->SetDiffuseMapName(m_sFont);
-		m_pMatMngr->ReloadMaps();
+		m_pMatMngr->m_materialList[nMaterial]->LoadMaps();
 	}
 	m_uMaterialIndex = nMaterial;
 }
@@ -84,41 +95,106 @@ void Text::CompileOpenGL3X(void)
 		return;
 
 	// Create a vertex array object
+	GLStateManager* pGLState = GLStateManager::GetInstance();
 	glGenVertexArrays(1, &m_vao);
-	glBindVertexArray(m_vao);
+	pGLState->BindVertexArray(m_vao);
 
 	// Create and initialize a buffer object for each shape.
 	glGenBuffers(1, &m_VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+	//the layout is fixed, the vertex array remembers it
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), BUFFER_OFFSET(offsetof(TextVertex, m_fPosition)));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), BUFFER_OFFSET(offsetof(TextVertex, m_fUV)));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextVertex), BUFFER_OFFSET(offsetof(TextVertex, m_uColor)));
+
+	pGLState->BindVertexArray(0);
 
 	m_bBinded = true;
 
 	return;
 }
-void Text::Render(void)
+void Text::BuildLines(uint& a_uDirtyBegin, uint& a_uDirtyEnd)
 {
-	float fSize = 7.0f;
-	bool bChange = false;
-	if (m_sText != m_sTextPrev || m_lColor != m_lColorPrev)
+	a_uDirtyBegin = 0;
+	a_uDirtyEnd = 0;
+	bool bDirty = false;
+
+	std::vector<TextLine> lLine;
+	uint uVertex = 0;
+	float fHeadY = 7.77f;
+	uint uStart = 0;
+	uint uLength = m_sText.size();
+	while (true)
 	{
-		bChange = true;
-		m_v3Head = vector3(-36.0f, 7.77f, 0);
-
-		m_lVertexPos.clear();
-		m_lVertexUV.clear();
-		m_lVertexCol.clear();
-
-		for (uint n = 0; n < m_sText.size(); n++)
+		//find the end of the line, the last one may be empty
+		uint uEnd = uStart;
+		while (uEnd < uLength && m_sText[uEnd] != '\n')
+			++uEnd;
+
+		TextLine oLine;
+		oLine.m_sText = m_sText.substr(uStart, (uEnd < uLength ? uEnd + 1 : uEnd) - uStart);
+		oLine.m_lColor.assign(m_lColor.begin() + uStart, m_lColor.begin() + uEnd);
+		oLine.m_fHeadY = fHeadY;
+		oLine.m_uFirst = uVertex;
+
+		//the same line at the same place already has its vertices in the buffer
+		uint uLine = lLine.size();
+		if (uLine < m_lLine.size() &&
+			m_lLine[uLine].m_uFirst == uVertex &&
+			m_lLine[uLine].m_fHeadY == fHeadY &&
+			m_lLine[uLine].m_sText == oLine.m_sText &&
+			m_lLine[uLine].m_lColor == oLine.m_lColor)
 		{
-			AddCharacter(m_sText[n], m_lColor[n]);
+			oLine.m_uCount = m_lLine[uLine].m_uCount;
+			oLine.m_fHeadYEnd = m_lLine[uLine].m_fHeadYEnd;
 		}
+		else
+		{
+			m_v3Head = vector3(-36.0f, fHeadY, 0.0f);
+			m_lGlyph.clear();
+			for (uint n = uStart; n < uEnd; n++)
+			{
+				AddCharacter(m_sText[n], m_lColor[n]);
+			}
+			if (uEnd < uLength)
+				AddCharacter('\n');
+			oLine.m_uCount = m_lGlyph.size();
+			oLine.m_fHeadYEnd = m_v3Head.y;
+
+			if (m_lVertex.size() < uVertex + oLine.m_uCount)
+				m_lVertex.resize(uVertex + oLine.m_uCount);
+			std::copy(m_lGlyph.begin(), m_lGlyph.end(), m_lVertex.begin() + uVertex);
+			if (!bDirty)
+				a_uDirtyBegin = uVertex;
+			a_uDirtyEnd = uVertex + oLine.m_uCount;
+			bDirty = true;
+		}
+		uVertex += oLine.m_uCount;
+		fHeadY = oLine.m_fHeadYEnd;
+		lLine.push_back(oLine);
 
-		m_lVertex.clear();
-		m_lVertex = m_lVertexPos;
-		m_lVertex.insert(m_lVertex.end(), m_lVertexCol.begin(), m_lVertexCol.end());
-		m_lVertex.insert(m_lVertex.end(), m_lVertexUV.begin(), m_lVertexUV.end());
+		if (uEnd == uLength)
+			break;
+		uStart = uEnd + 1;
 	}
+	m_lVertex.resize(uVertex);
+	m_lLine.swap(lLine);
+	m_uVertexCount = uVertex;
+}
+void Text::Render(void)
+{
+	float fSize = 7.0f;
 
-	m_uVertexCount = m_lVertexPos.size();
+	uint uDirtyBegin = 0;
+	uint uDirtyEnd = 0;
+	BuildLines(uDirtyBegin, uDirtyEnd);
+
+	m_sText = "";
+	m_lColor.clear();
 
 	if (m_uVertexCount == 0)
 		return;
@@ -126,73 +202,55 @@ void Text::Render(void)
 	if (!m_bBinded)
 		return;
 
-	GLuint nShader = m_nShader;
-	// Use the buffer and shader
-	glUseProgram(nShader);
-	glBindVertexArray(m_vao);
-	// Get the GPU variables by their name and hook them to CPU variables
+	// Use the buffer and shader, a wireframe mesh may have left the polygons as lines
+	GLStateManager* pGLState = GLStateManager::GetInstance();
+	pGLState->UseProgram(m_nShader);
+	pGLState->BindVertexArray(m_vao);
+	pGLState->SetPolygonMode(GL_FILL);
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 
-	GLuint Position_b = glGetAttribLocation(nShader, "Position_b");
-	GLuint UV_b = glGetAttribLocation(nShader, "UV_b");
-	GLuint Color_b = glGetAttribLocation(nShader, "Color_b");
+	//grow the buffer if needed, otherwise only send the vertices that changed
+	if (m_uVertexCount > m_uBufferCapacity)
+	{
+		m_uBufferCapacity = std::max(m_uVertexCount, 2 * m_uBufferCapacity);
+		glBufferData(GL_ARRAY_BUFFER, m_uBufferCapacity * sizeof(TextVertex), nullptr, GL_DYNAMIC_DRAW);
+		uDirtyBegin = 0;
+		uDirtyEnd = m_uVertexCount;
+	}
+	if (uDirtyEnd > uDirtyBegin)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, uDirtyBegin * sizeof(TextVertex),
+			(uDirtyEnd - uDirtyBegin) * sizeof(TextVertex), &m_lVertex[uDirtyBegin]);
+	}
 
-	GLuint MVP = glGetUniformLocation(nShader, "MVP");
-	GLuint TextureID = glGetUniformLocation(nShader, "TextureID");
-	
-	float fRatio = static_cast<float>(m_pSystem->GetWindowWidth()) / static_cast<float>(m_pSystem->GetWindowHeight());
-	
 	//matrix4 mProjection = glm::ortho(-fSize, fSize, -fSize + fSize / 10.0f, fSize / 10.0f, 0.1f, 1.1f);
 	matrix4 mProjection = glm::ortho(-fSize, fSize, -fSize, fSize, 0.1f, 1.1f);
 	matrix4 mView = glm::lookAt(vector3(0.0f, 0.0f, 1.0f), ZERO_V3, AXIS_Y);
 
+	//a hot reload relinks the program in place, its uniforms may have moved
+	if (m_uShaderReload != m_pShaderMngr->GetReloadCount())
+		FindUniforms();
+
 	//Final Projection of the Camera
-	glUniformMatrix4fv(MVP, 1, GL_FALSE, glm::value_ptr(mProjection * mView));
+	glUniformMatrix4fv(m_nMVP, 1, GL_FALSE, glm::value_ptr(mProjection * mView));
 	
 	// Bind our texture in Texture Unit 0
 	int nMaterialIndex = m_uMaterialIndex;
 	if (m_pMatMngr->m_materialList[nMaterialIndex]->GetDiffuseMapName() != "NULL")
 	{
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, m_pMatMngr->m_materialList[nMaterialIndex]->GetDiffuseMap());
-		glUniform1i(TextureID, 0);
+		pGLState->BindTexture(0, m_pMatMngr->m_materialList[nMaterialIndex]->GetDiffuseMap());
+		glUniform1i(m_nTextureID, 0);
 	}
 
-	//vertex
-	glEnableVertexAttribArray(Position_b);
-	glEnableVertexAttribArray(UV_b);
-	glEnableVertexAttribArray(Color_b);
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-	if (bChange)
-	{
-		glBufferData(GL_ARRAY_BUFFER, 3 * m_uVertexCount * sizeof(vector3), &m_lVertex[0], GL_DYNAMIC_DRAW);
-	}
-	glVertexAttribPointer(Position_b, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-	glVertexAttribPointer(Color_b, 3, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(m_uVertexCount * sizeof(vector3)));
-	glVertexAttribPointer(UV_b, 3, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(2 * m_uVertexCount * sizeof(vector3)));
-
 	//Color and draw
 	glDrawArrays(GL_TRIANGLES, 0, m_uVertexCount);
-
-	glDisable(GL_TEXTURE0);
-
-	glDisableVertexAttribArray(Position_b);
-	glDisableVertexAttribArray(UV_b);
-	glDisableVertexAttribArray(Color_b);
-
-	m_sTextPrev = m_sText;
-	m_sText = "";
-	m_lColorPrev = m_lColor;
-	m_lColor.clear();
-
-	glBindVertexArray(0);
 }
 void Text::Reset(void)
 {
 	m_v3Head = vector3(-26, 0, 0);
 
-	m_lVertexPos.clear();
-	m_lVertexUV.clear();
-	m_lVertexCol.clear();
+	m_lVertex.clear();
+	m_lLine.clear();
 
 	m_uVertexCount = 0;
 
@@ -237,31 +295,30 @@ void Text::AddCharacter(char a_cInput, vector3 a_v3Color)
 	int nColumn = nIndex % 10;
 	int nRow = static_cast<int>(nIndex / 10);
 
-	m_lVertexPos.push_back(vector3(0.0f + (vOffset.x * m_v3Head.x), 0.0f + (vOffset.y * m_v3Head.y), 0.0f));
-	m_lVertexPos.push_back(vector3(vOffset.x + (vOffset.x * m_v3Head.x), 0.0f + (vOffset.y * m_v3Head.y), 0.0f));
-	m_lVertexPos.push_back(vector3(0.0f + (vOffset.x * m_v3Head.x), vOffset.y + (vOffset.y * m_v3Head.y), 0.0f));
-
-	m_lVertexPos.push_back(vector3(0.0f + (vOffset.x * m_v3Head.x), vOffset.y + (vOffset.y * m_v3Head.y), 0.0f));
-	m_lVertexPos.push_back(vector3(vOffset.x + (vOffset.x * m_v3Head.x), 0.0f + (vOffset.y * m_v3Head.y), 0.0f));
-	m_lVertexPos.push_back(vector3(vOffset.x + (vOffset.x * m_v3Head.x), vOffset.y + (vOffset.y * m_v3Head.y), 0.0f));
+	float fLeft = vOffset.x * m_v3Head.x;
+	float fRight = vOffset.x + fLeft;
+	float fBottom = vOffset.y * m_v3Head.y;
+	float fTop = vOffset.y + fBottom;
 
 	vector3 vUV = vector3(0.1f, 0.1f, 0.0f);
-
-	m_lVertexUV.push_back(vector3(0.0f + vUV.x * nColumn, 0.9f - vUV.y * nRow, 0.0f));
-	m_lVertexUV.push_back(vector3(0.1f + vUV.x * nColumn, 0.9f - vUV.y * nRow, 0.0f));
-	m_lVertexUV.push_back(vector3(0.0f + vUV.x * nColumn, 1.0f - vUV.y * nRow, 0.0f));
-
-	m_lVertexUV.push_back(vector3(0.0f + vUV.x * nColumn, 1.0f - vUV.y * nRow, 0.0f));
-	m_lVertexUV.push_back(vector3(0.1f + vUV.x * nColumn, 0.9f - vUV.y * nRow, 0.0f));
-	m_lVertexUV.push_back(vector3(0.1f + vUV.x * nColumn, 1.0f - vUV.y * nRow, 0.0f));
-
-	m_lVertexCol.push_back(a_v3Color);
-	m_lVertexCol.push_back(a_v3Color);
-	m_lVertexCol.push_back(a_v3Color);
-
-	m_lVertexCol.push_back(a_v3Color);
-	m_lVertexCol.push_back(a_v3Color);
-	m_lVertexCol.push_back(a_v3Color);
+	float fU0 = 0.0f + vUV.x * nColumn;
+	float fU1 = 0.1f + vUV.x * nColumn;
+	float fV0 = 0.9f - vUV.y * nRow;
+	float fV1 = 1.0f - vUV.y * nRow;
+
+	vector3 v3Color = glm::clamp(a_v3Color, 0.0f, 1.0f) * 255.0f;
+	uint uColor = static_cast<uint>(v3Color.r + 0.5f) |
+		(static_cast<uint>(v3Color.g + 0.5f) << 8) |
+		(static_cast<uint>(v3Color.b + 0.5f) << 16) |
+		(255u << 24);
+
+	m_lGlyph.push_back({ { fLeft, fBottom }, { fU0, fV0 }, uColor });
+	m_lGlyph.push_back({ { fRight, fBottom }, { fU1, fV0 }, uColor });
+	m_lGlyph.push_back({ { fLeft, fTop }, { fU0, fV1 }, uColor });
+
+	m_lGlyph.push_back({ { fLeft, fTop }, { fU0, fV1 }, uColor });
+	m_lGlyph.push_back({ { fRight, fBottom }, { fU1, fV0 }, uColor });
+	m_lGlyph.push_back({ { fRight, fTop }, { fU1, fV1 }, uColor });
 
 	m_v3Head.x += 1.0f;
 
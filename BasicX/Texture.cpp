@@ -8,6 +8,12 @@ Texture::~Texture(void) { Release(); }
 
 void Texture::Release(void)
 {
+	if (m_pBitmap)
+	{
+		FreeImage_Unload(m_pBitmap);
+		m_pBitmap = nullptr;
+	}
+	GLStateManager::GetInstance()->ForgetTexture(m_nTextureID);
 	glDeleteTextures(1, &m_nTextureID);
 }
 void Texture::Init(void)
@@ -15,8 +21,19 @@ void Texture::Init(void)
 	m_nTextureID = 0;
 	m_pSystem = SystemSingleton::GetInstance();
 	m_sAbsoluteRoute = "";
+	m_pBitmap = nullptr;
+	m_uWidth = 0;
+	m_uHeight = 0;
 }
 bool Texture::LoadTexture(String a_sFileName)
+{
+	if (!ReserveTexture(a_sFileName))
+		return false;
+	if (!DecodeTexture())
+		return false;
+	return UploadTexture();
+}
+bool Texture::ReserveTexture(String a_sFileName)
 {
 	if (a_sFileName == "NULL")
 		return false;
@@ -41,68 +58,62 @@ bool Texture::LoadTexture(String a_sFileName)
 	if (!FileReader::FileExists(m_sFileName))
 		return false;
 
+	if(m_nTextureID > 0)// if the texture is already binded
+	{
+		GLStateManager::GetInstance()->ForgetTexture(m_nTextureID);
+		glDeleteTextures(1, &m_nTextureID);
+	}
+
+	//Generate the OpenGL texture object with a single white texel until the image gets uploaded
+	GLubyte white[4] = { 255, 255, 255, 255 };
+	glGenTextures(1, &m_nTextureID); //Generate a container
+	GLStateManager::GetInstance()->BindTexture(0, m_nTextureID, true); //Set the active texture
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)white);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	return true;
+}
+bool Texture::DecodeTexture(void)
+{
 	//Based on Raul's implementation: http://www.raul-art.blogspot.com
 	FREE_IMAGE_FORMAT eFormat = FreeImage_GetFileType(m_sFileName.c_str(), 0);//Detect the file format
 	FIBITMAP* image = FreeImage_Load(eFormat, m_sFileName.c_str()); //Load the file as FreeImage imagefile
-	image = FreeImage_ConvertTo32Bits(image); //convert to 32bits
+	if (image == nullptr)
+		return false;
+	m_pBitmap = FreeImage_ConvertTo32Bits(image); //convert to 32bits
+	FreeImage_Unload(image); //the conversion is a copy, unload the original
+	if (m_pBitmap == nullptr)
+		return false;
 
-	int w = FreeImage_GetWidth(image);
-	int h = FreeImage_GetHeight(image);
+	m_uWidth = FreeImage_GetWidth(m_pBitmap);
+	m_uHeight = FreeImage_GetHeight(m_pBitmap);
 #ifdef DEBUG
 	std::cout << "Texture loaded " << m_sFileName.c_str() << std::endl; //Some debugging code
-	std::cout << "               With size [ " << w << " * " << h << "]" << std::endl;
+	std::cout << "               With size [ " << m_uWidth << " * " << m_uHeight << "]" << std::endl;
 #endif
-	GLubyte* tempGLTexture = new GLubyte[4 * w * h];//Create a new texture to hold the information onto
-	char* pixeles = (char*)FreeImage_GetBits(image);//Create a pixel container
-							 //FreeImage loads in BGRA format, so you need to swap some bytes (Or use GL_BGR).
-	for (int nPixel = 0; nPixel < (w * h); nPixel++)
-	{
-		tempGLTexture[nPixel * 4 + 0] = pixeles[nPixel * 4 + 2];
-		tempGLTexture[nPixel * 4 + 1] = pixeles[nPixel * 4 + 1];
-		tempGLTexture[nPixel * 4 + 2] = pixeles[nPixel * 4 + 0];
-		tempGLTexture[nPixel * 4 + 3] = pixeles[nPixel * 4 + 3];
-	}
-	FreeImage_Unload(image); //OUT_DONE with the image, unload it
+	return true;
+}
+bool Texture::UploadTexture(void)
+{
+	if (m_pBitmap == nullptr)
+		return false;
 
-	if(m_nTextureID > 0)// if the texture is already binded
-	{
-		glDeleteTextures(1, &m_nTextureID);
-/*#if _MSC_VER == 1800 //If visual studio 2013
-		 /*m_nTextureID = SOIL_load_OGL_texture
-		(
-			m_sFileName.c_str(),
-			SOIL_LOAD_AUTO,
-			SOIL_CREATE_NEW_ID,
-			SOIL_FLAG_INVERT_Y 
-		);
-#elif _MSC_VER == 1900 //If visual studio 2015
-		
-		
-//#endif*/
-	}
-	//else
-	//{
-	//	m_nTextureID = SOIL_load_OGL_texture
-	//	(
-	//		m_sFileName.c_str(),
-	//		SOIL_LOAD_AUTO,
-	//		m_nTextureID,
-	//		SOIL_FLAG_INVERT_Y
-	//	);
-	//}
+	if (m_nTextureID == 0)
+		glGenTextures(1, &m_nTextureID); //Generate a container
 
-	//Now generate the OpenGL texture object 
-	glGenTextures(1, &m_nTextureID); //Generate a container
-	glBindTexture(GL_TEXTURE_2D, m_nTextureID); //Set the active texture
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)tempGLTexture); //Set the data
+	//FreeImage loads in BGRA format, OpenGL swizzles it on upload so there is no need for a copy
+	GLStateManager::GetInstance()->BindTexture(0, m_nTextureID, true); //Set the active texture
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4); //32 bit rows are always 4 byte aligned
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_uWidth, m_uHeight, 0, GL_BGRA, GL_UNSIGNED_BYTE,
+		(GLvoid*)FreeImage_GetBits(m_pBitmap)); //Set the data
+	glGenerateMipmap(GL_TEXTURE_2D);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	//glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	FreeImage_Unload(m_pBitmap); //OUT_DONE with the image, unload it
+	m_pBitmap = nullptr;
 
 	if (glGetError())
 	{
@@ -111,6 +122,12 @@ bool Texture::LoadTexture(String a_sFileName)
 	}
 	return true;
 }
+uint Texture::GetDecodedSize(void)
+{
+	if (m_pBitmap == nullptr)
+		return 0;
+	return 4 * m_uWidth * m_uHeight;
+}
 
 //Accessors
 GLuint Texture::GetGLTextureID(void){return m_nTextureID;}
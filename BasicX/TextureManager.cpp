@@ -24,6 +24,21 @@ void TextureManager::ReleaseInstance()
 //--- Non Standard Singleton Methods
 void TextureManager::Release(void)
 {
+	//stop the worker before deleting the textures it may be decoding
+	if (m_bWorkerRunning)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bStopWorker = true;
+		}
+		m_condition.notify_all();
+		m_worker.join();
+		m_bWorkerRunning = false;
+	}
+	m_decodeQueue.clear();
+	m_uploadQueue.clear();
+	m_resolvedMap.clear();
+
 	int nTextures = static_cast<int>(m_textureList.size());
 	for(int nTexture = 0; nTexture < nTextures; nTexture++)
 	{
@@ -80,6 +95,111 @@ int TextureManager::LoadTexture(String a_sName)
 	}
 	return nTexture;
 }
+int TextureManager::LoadTextureAsync(String a_sName)
+{
+	if ("NULL" == a_sName || " " == a_sName || "null" == a_sName || "Null" == a_sName)
+		return -1;
+	int nTexture = IdentifyTexure(a_sName);
+	if (nTexture != -1)
+		return nTexture;
+
+	Texture* pTextureTemp = new Texture();
+	if (!pTextureTemp->ReserveTexture(a_sName))
+	{
+		delete pTextureTemp;
+		pTextureTemp = nullptr;
+		return -1;
+	}
+	m_textureList.push_back(pTextureTemp);
+	nTexture = GetTextureCount() - 1;
+	m_map[pTextureTemp->GetFileName()] = nTexture;
+
+	//start the worker the first time it is needed
+	if (!m_bWorkerRunning)
+	{
+		m_bStopWorker = false;
+		m_worker = std::thread(&TextureManager::DecodeWorker, this);
+		m_bWorkerRunning = true;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_decodeQueue.push_back(pTextureTemp);
+	}
+	m_condition.notify_one();
+	return nTexture;
+}
+int TextureManager::ResolveTexture(String a_sName, String a_sRoute, String a_sModel)
+{
+	if ("NULL" == a_sName || " " == a_sName || "null" == a_sName || "Null" == a_sName)
+		return -1;
+
+	//if we already looked for this texture in this folder reuse the answer
+	String sKey = a_sRoute + "|" + a_sModel + "|" + a_sName;
+	auto var = m_resolvedMap.find(sKey);
+	if (var != m_resolvedMap.end())
+		return var->second;
+
+	int nTexture = -1;
+	if (a_sRoute != "")
+	{
+		//the same folder, different folders at the same level as the model and the fbx subfolder
+		String sFolder[] = { "", "Textures\\", "Texture\\", "Material\\", "Materials\\", a_sModel + ".fbm\\" };
+		for (uint nFolder = 0; nFolder < 6 && nTexture < 0; ++nFolder)
+			nTexture = LoadTextureAsync(a_sRoute + sFolder[nFolder] + a_sName);
+	}
+	//if we could not find it try it from the default texture folder
+	if (nTexture < 0)
+		nTexture = LoadTextureAsync(a_sName);
+
+	m_resolvedMap[sKey] = nTexture;
+	return nTexture;
+}
+void TextureManager::ClearResolvedTextures(void) { m_resolvedMap.clear(); }
+uint TextureManager::Update(void)
+{
+	uint uUploaded = 0;
+	uint uBytes = 0;
+	while (true)
+	{
+		Texture* pTexture = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_uploadQueue.empty())
+				break;
+			pTexture = m_uploadQueue.front();
+			//always upload one so big textures do not wait forever
+			if (uUploaded > 0 && uBytes + pTexture->GetDecodedSize() > m_uUploadBudget)
+				break;
+			m_uploadQueue.pop_front();
+		}
+		uBytes += pTexture->GetDecodedSize();
+		pTexture->UploadTexture();
+		++uUploaded;
+	}
+	return uUploaded;
+}
+void TextureManager::SetUploadBudget(uint a_uBytes) { m_uUploadBudget = a_uBytes; }
+void TextureManager::DecodeWorker(void)
+{
+	while (true)
+	{
+		Texture* pTexture = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this] { return m_bStopWorker || !m_decodeQueue.empty(); });
+			if (m_bStopWorker)
+				return;
+			pTexture = m_decodeQueue.front();
+			m_decodeQueue.pop_front();
+		}
+		//decoding does not touch OpenGL, if it fails the texture stays white
+		if (pTexture->DecodeTexture())
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_uploadQueue.push_back(pTexture);
+		}
+	}
+}
 void TextureManager::SaveTexture(String a_sTextureName)
 {
 	//working on this still, weird tint in the texture.
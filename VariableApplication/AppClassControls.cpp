@@ -49,6 +49,8 @@ void AppClass::ProcessKeyboard(void)
 	ON_KEY_PRESS_RELEASE(F2, NULL, m_pCameraMngr->SetCameraMode(CAM_ORTHO_Z));
 	ON_KEY_PRESS_RELEASE(F3, NULL, m_pCameraMngr->SetCameraMode(CAM_ORTHO_Y));
 	ON_KEY_PRESS_RELEASE(F4, NULL, m_pCameraMngr->SetCameraMode(CAM_ORTHO_X));
+	ShaderManager* pShaderMngr = ShaderManager::GetInstance();
+	ON_KEY_PRESS_RELEASE(F5, NULL, pShaderMngr->SetHotReload(!pShaderMngr->IsHotReload()));
 	static bool bFPSControll = false;
 	ON_KEY_PRESS_RELEASE(F, bFPSControll = !bFPSControll, m_pCameraMngr->SetFPS(bFPSControll));
 #pragma endregion
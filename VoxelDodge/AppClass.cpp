@@ -1,5 +1,20 @@
 #include "AppClass.h"
 using namespace Simplex;
+/*
+USAGE: Random point on a sphere, same distribution as glm::sphericalRand but from a generator we can seed
+ARGUMENTS:
+-	std::mt19937& a_Random -> generator
+-	float a_fRadius -> radius of the sphere
+OUTPUT: point on the sphere
+*/
+static vector3 SphericalRand(std::mt19937& a_Random, float a_fRadius)
+{
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+	float fZ = distribution(a_Random) * 2.0f - 1.0f;
+	float fAngle = distribution(a_Random) * glm::two_pi<float>();
+	float fRadius = std::sqrt(1.0f - fZ * fZ) * a_fRadius;
+	return vector3(fRadius * std::cos(fAngle), fRadius * std::sin(fAngle), fZ * a_fRadius);
+}
 void Application::InitVariables(void)
 {
 	//Set the position and target of the camera
@@ -10,21 +25,38 @@ void Application::InitVariables(void)
 
 	m_pLightMngr->SetPosition(vector3(0.0f, 3.0f, 13.0f), 1); //set the position of first light (0 is reserved for ambient light)
 
-	m_pEntityMngr->AddEntity("Minecraft\\Steve.obj", "Steve");
-	m_pEntityMngr->UsePhysicsSolver();
-	
-	for (int i = 0; i < 100; i++)
+	m_Random.seed(m_uSeed);
+	m_uStepClock = m_pSystem->GenClock();
+
+	//a scene saved with F9 (or its text twin edited by hand) replaces the generated one
+	if (!m_Scene.Load("VoxelDodge.scene") && !m_Scene.LoadText("VoxelDodge.scene.txt"))
 	{
-		m_pEntityMngr->AddEntity("Minecraft\\Cube.obj", "Cube_" + std::to_string(i));
-		vector3 v3Position = vector3(glm::sphericalRand(12.0f));
-		v3Position.y = 0.0f;
-		matrix4 m4Position = glm::translate(v3Position);
-		m_pEntityMngr->SetModelMatrix(m4Position * glm::scale(vector3(2.0f)));
-		m_pEntityMngr->UsePhysicsSolver();
-		//m_pEntityMngr->SetMass(2);
+		m_Scene.Reserve(101);
+		MySceneEntity steve;
+		steve.m_sUniqueID = "Steve";
+		steve.m_uPrototype = m_Scene.AddPrototype("Minecraft\\Steve.obj");
+		steve.m_bPhysics = true;
+		m_Scene.AddEntity(steve);
 
-		//m_pEntityMngr->SetMass(i+1);
+		uint uCube = m_Scene.AddPrototype("Minecraft\\Cube.obj");
+		for (int i = 0; i < 100; i++)
+		{
+			MySceneEntity cube;
+			cube.m_sUniqueID = "Cube_" + std::to_string(i);
+			cube.m_uPrototype = uCube;
+			cube.m_v3Position = SphericalRand(m_Random, 12.0f);
+			cube.m_v3Position.y = 0.0f;
+			cube.m_v3Scale = vector3(2.0f);
+			cube.m_bPhysics = true;
+			//cube.m_fMass = 2.0f;
+			m_Scene.AddEntity(cube);
+		}
 	}
+	uint uLoadClock = m_pSystem->GenClock();
+	m_pSystem->StartClock(uLoadClock);
+	m_pEntityMngr->LoadScene(m_Scene);
+	m_fSceneLoadTime = m_pSystem->GetDeltaTime(uLoadClock);
+	m_hSteve = m_pEntityMngr->GetEntityHandle("Steve");
 }
 void Application::Update(void)
 {
@@ -37,8 +69,22 @@ void Application::Update(void)
 	//Is the first person camera active?
 	CameraRotation();
 
-	//Update Entity Manager
-	m_pEntityMngr->Update();
+	//Update Entity Manager, in fixed step mode the simulation runs at its own rate whatever the frame rate
+	if (m_bFixedStep)
+	{
+		m_fStepTime += m_pSystem->GetDeltaTime(m_uStepClock);
+		uint uSteps = 0;
+		while (m_fStepTime >= SIMULATION_STEP && uSteps < SIMULATION_MAX_STEPS)
+		{
+			m_pEntityMngr->Update();
+			m_fStepTime -= SIMULATION_STEP;
+			++uSteps;
+		}
+		if (m_fStepTime >= SIMULATION_STEP)
+			m_fStepTime = 0.0f;
+	}
+	else
+		m_pEntityMngr->Update();
 
 	//Set the model matrix for the main object
 	//m_pEntityMngr->SetModelMatrix(m_m4Steve, "Steve");
@@ -11,13 +11,28 @@ Date: 2017/06
 #include "imgui\ImGuiObject.h"
 
 #include "MyEntityManager.h"
+#include <random>
 
 namespace Simplex
 {
+//Length of a simulation step in fixed step mode, in seconds
+#define SIMULATION_STEP (1.0f / 60.0f)
+//Steps a frame can run to catch up, the time past that is dropped so a slow frame does not pile up
+#define SIMULATION_MAX_STEPS 4
+
 //Adding Application to the Simplex namespace
 class Application
 {
 	MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager
+	MyEntityHandle m_hSteve; //Handle of the player entity, resolved once instead of looking up "Steve" every frame
+	uint m_uSeed = 2185; //seed of the scene generator, the same seed builds the same scene
+	std::mt19937 m_Random; //scene generator, glm::sphericalRand cannot be seeded
+	bool m_bFixedStep = false; //is the simulation stepped at a fixed rate instead of once per frame?
+	uint m_uStepClock = 0; //clock of the fixed steps
+	float m_fStepTime = 0.0f; //time the fixed steps have not simulated yet
+	MyScene m_Scene; //scene loaded at the start, F9 writes it to VoxelDodge.scene and its text twin
+	float m_fSceneLoadTime = 0.0f; //seconds MyEntityManager::LoadScene took to build the scene
+	MySnapshot m_Snapshot; //state saved with F5, F6 rewinds to it and replays the inputs since
 private:
 	String m_sProgrammer = "Alberto Bobadilla - labigm@rit.edu"; //programmer
 
@@ -73,7 +73,7 @@ void Application::ProcessKeyPressed(sf::Event a_event)
 	default: break;
 	case sf::Keyboard::Space:
 		m_sound.play();
-		m_pEntityMngr->ApplyForce(vector3(0.0f, 1.0f, 0.0f), "Steve");
+		m_pEntityMngr->ApplyForce(vector3(0.0f, 1.0f, 0.0f), m_hSteve);
 		break;
 	case sf::Keyboard::LShift:
 	case sf::Keyboard::RShift:
@@ -108,6 +108,53 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 	case sf::Keyboard::F4:
 		m_pCameraMngr->SetCameraMode(CAM_ORTHO_X);
 		break;
+	case sf::Keyboard::F5:
+		//save the state and record the inputs from here on
+		m_Snapshot.Clear();
+		m_pEntityMngr->SaveSnapshot(m_Snapshot);
+		m_pEntityMngr->SetRecording(true);
+		break;
+	case sf::Keyboard::F6:
+		//go back to the saved state and play the recorded inputs again up to where we were
+		if (!m_Snapshot.IsEmpty())
+		{
+			m_Snapshot.Seek();
+			if (m_pEntityMngr->LoadSnapshot(m_Snapshot))
+				m_pEntityMngr->SetReplaying(true);
+		}
+		break;
+	case sf::Keyboard::F7:
+		m_bFixedStep = !m_bFixedStep;
+		m_pSystem->ResetClock(m_uStepClock);
+		m_fStepTime = 0.0f;
+		break;
+	case sf::Keyboard::F8:
+		//the saved state and the inputs since, to simulate the same frames on another build
+		if (!m_Snapshot.IsEmpty())
+		{
+			MySnapshot file(m_Snapshot);
+			m_pEntityMngr->SaveInputLog(file);
+			file.SaveFile("VoxelDodge.sim");
+		}
+		break;
+	case sf::Keyboard::F10:
+		//simulate a run written with F8 again, the scene has to be the one it was recorded on
+		{
+			MySnapshot file;
+			if (!file.LoadFile("VoxelDodge.sim") || !m_pEntityMngr->LoadSnapshot(file) ||
+				!m_pEntityMngr->LoadInputLog(file))
+				break;
+			//the file starts with the state, F6 can rewind to it and replay the run once more
+			m_Snapshot = file;
+			m_pEntityMngr->SetRecording(false);
+			m_pEntityMngr->SetReplaying(true);
+		}
+		break;
+	case sf::Keyboard::F9:
+		//the scene as it was loaded, the next run starts from these files
+		m_Scene.Save("VoxelDodge.scene");
+		m_Scene.SaveText("VoxelDodge.scene.txt");
+		break;
 	case sf::Keyboard::F:
 		bFPSControl = !bFPSControl;
 		m_pCameraMngr->SetFPS(bFPSControl);
@@ -416,22 +463,22 @@ void Application::ProcessKeyboard(void)
 	float fDelta = m_pSystem->GetDeltaTime(0);
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
 	{
-		m_pEntityMngr->ApplyForce(vector3(-2.0f * fDelta, 0.0f, 0.0f), "Steve");
+		m_pEntityMngr->ApplyForce(vector3(-2.0f * fDelta, 0.0f, 0.0f), m_hSteve);
 	}
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
 	{
-		m_pEntityMngr->ApplyForce(vector3(2.0f * fDelta, 0.0f, 0.0f), "Steve");
+		m_pEntityMngr->ApplyForce(vector3(2.0f * fDelta, 0.0f, 0.0f), m_hSteve);
 	}
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
 	{
-		m_pEntityMngr->ApplyForce(vector3(0.0f, 0.0f, -2.0f * fDelta), "Steve");
+		m_pEntityMngr->ApplyForce(vector3(0.0f, 0.0f, -2.0f * fDelta), m_hSteve);
 	}
 
 	if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
 	{
-		m_pEntityMngr->ApplyForce(vector3(0.0f, 0.0f, 2.0f * fDelta), "Steve");
+		m_pEntityMngr->ApplyForce(vector3(0.0f, 0.0f, 2.0f * fDelta), m_hSteve);
 	}
 #pragma endregion
 }
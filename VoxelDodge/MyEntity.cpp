@@ -1,34 +1,38 @@
 #include "MyEntity.h"
 using namespace Simplex;
-std::map<String, MyEntity*> MyEntity::m_IDMap;
+std::map<String, MyEntity::MyPrototype> MyEntity::m_PrototypeMap;
 //  Accessors
 Simplex::MySolver* Simplex::MyEntity::GetSolver(void) { return m_pSolver; }
 bool Simplex::MyEntity::HasThisRigidBody(MyRigidBody* a_pRigidBody) { return m_pRigidBody == a_pRigidBody; }
 Simplex::MyRigidBody::PRigidBody* Simplex::MyEntity::GetColliderArray(void) { return m_pRigidBody->GetColliderArray(); }
 uint Simplex::MyEntity::GetCollidingCount(void) { return m_pRigidBody->GetCollidingCount(); }
-matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_m4ToWorld; }
+matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_Transform.GetMatrix(); }
 void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 {
 	if (!m_bInMemory)
 		return;
 
-	m_m4ToWorld = a_m4ToWorld;
-	m_pModel->SetModelMatrix(m_m4ToWorld);
-	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
+	//matrices coming from outside are split once here, the physics step works on the parts
+	m_Transform.SetMatrix(a_m4ToWorld);
 
-	//experimental way of calculating a matrix components
-	glm::vec3 scale;
-	glm::quat rotation;
-	glm::vec3 translation;
-	glm::vec3 skew;
-	glm::vec4 perspective;
-	glm::decompose(m_m4ToWorld, scale, rotation, translation, skew, perspective);
-
-	m_pSolver->SetPosition(translation);
-	m_pSolver->SetSize(scale);
+	//if it did not change there is nothing to push down (static and resting entities)
+	if (m_Transform.GetChange() == TRANSFORM_NONE)
+		return;
 
-	//m_pSolver->SetPosition(vector3(m_m4ToWorld[3]));
+	m_pSolver->SetPosition(m_Transform.GetPosition());
+	m_pSolver->SetSize(m_Transform.GetScale());
+	ApplyTransform();
+}
+Simplex::MyTransform* Simplex::MyEntity::GetTransform(void) { return &m_Transform; }
+void Simplex::MyEntity::ApplyTransform(void)
+{
+	if (!m_bInMemory || m_Transform.GetChange() == TRANSFORM_NONE)
+		return;
 
+	//the model composes the world matrices of its groups from this one
+	m_pModel->SetModelMatrix(m_Transform.GetMatrix());
+	m_pRigidBody->SetTransform(m_Transform);
+	m_Transform.ClearChange();
 }
 Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
 MyRigidBody* Simplex::MyEntity::GetRigidBody(void){	return m_pRigidBody; }
@@ -65,20 +69,23 @@ void Simplex::MyEntity::Init(void)
 	m_bInMemory = false;
 	m_bSetAxis = false;
 	m_pModel = nullptr;
+	m_pPrototype = nullptr;
 	m_pRigidBody = nullptr;
 	m_DimensionArray = nullptr;
-	m_m4ToWorld = IDENTITY_M4;
+	m_Transform = MyTransform();
 	m_sUniqueID = "";
 	m_nDimensionCount = 0;
 	m_bUsePhysicsSolver = false;
 	m_pSolver = nullptr;
+	m_bSolverOwned = true;
 }
 void Simplex::MyEntity::Swap(MyEntity& other)
 {
 	m_bInMemory = false;
 	std::swap(m_pModel, other.m_pModel);
+	std::swap(m_pPrototype, other.m_pPrototype);
 	std::swap(m_pRigidBody, other.m_pRigidBody);
-	std::swap(m_m4ToWorld, other.m_m4ToWorld);
+	m_Transform.Swap(other.m_Transform);
 	std::swap(m_pMeshMngr, other.m_pMeshMngr);
 	std::swap(m_bInMemory, other.m_bInMemory);
 	std::swap(m_sUniqueID, other.m_sUniqueID);
@@ -86,6 +93,7 @@ void Simplex::MyEntity::Swap(MyEntity& other)
 	std::swap(m_nDimensionCount, other.m_nDimensionCount);
 	std::swap(m_DimensionArray, other.m_DimensionArray);
 	std::swap(m_pSolver, other.m_pSolver);
+	std::swap(m_bSolverOwned, other.m_bSolverOwned);
 }
 void Simplex::MyEntity::Release(void)
 {
@@ -93,45 +101,56 @@ void Simplex::MyEntity::Release(void)
 	//it is not the job of the entity to release the model, 
 	//it is for the mesh manager to do so.
 	m_pModel = nullptr;
+	m_pPrototype = nullptr;
 	if (m_DimensionArray)
 	{
 		delete[] m_DimensionArray;
 		m_DimensionArray = nullptr;
 	}
 	SafeDelete(m_pRigidBody);
-	SafeDelete(m_pSolver);
-	m_IDMap.erase(m_sUniqueID);
+	//a solver stored in the manager array is not ours to release
+	if (m_bSolverOwned)
+	{
+		SafeDelete(m_pSolver);
+	}
+	m_pSolver = nullptr;
 }
 //The big 3
 Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
 {
 	Init();
-	m_pModel = new Model();
-	m_pModel->Load(a_sFileName);
-	//if the model is loaded
-	if (m_pModel->GetName() != "")
-	{
-		GenUniqueID(a_sUniqueID);
-		m_sUniqueID = a_sUniqueID;
-		m_IDMap[a_sUniqueID] = this;
-		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); //generate a rigid body
-		m_bInMemory = true; //mark this entity as viable
-	}
-	m_pSolver = new MySolver();
+	Spawn(GetPrototype(a_sFileName), a_sUniqueID);
+}
+Simplex::MyEntity::MyEntity(MyPrototype* a_pPrototype, String a_sUniqueID)
+{
+	Init();
+	Spawn(a_pPrototype, a_sUniqueID);
 }
 Simplex::MyEntity::MyEntity(MyEntity const& other)
 {
 	m_bInMemory = other.m_bInMemory;
 	m_pModel = other.m_pModel;
+	m_pPrototype = other.m_pPrototype;
 	//generate a new rigid body we do not share the same rigid body as we do the model
-	m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); 
-	m_m4ToWorld = other.m_m4ToWorld;
+	if (m_pPrototype != nullptr)
+		m_pRigidBody = new MyRigidBody(*m_pPrototype->m_pRigidBody);
+	else
+		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList());
+	m_Transform = other.m_Transform;
+	m_pRigidBody->SetModelMatrix(m_Transform.GetMatrix()); //SetModelMatrix skips unchanged matrices, place it now
 	m_pMeshMngr = other.m_pMeshMngr;
 	m_sUniqueID = other.m_sUniqueID;
 	m_bSetAxis = other.m_bSetAxis;
 	m_nDimensionCount = other.m_nDimensionCount;
-	m_DimensionArray = other.m_DimensionArray;
+	//the dimension storage is owned by each entity, copy it
+	m_DimensionArray = nullptr;
+	if (other.m_DimensionArray)
+	{
+		m_DimensionArray = new uint[m_nDimensionCount];
+		memcpy(m_DimensionArray, other.m_DimensionArray, sizeof(uint) * m_nDimensionCount);
+	}
 	m_pSolver = new MySolver(*other.m_pSolver);
+	m_bSolverOwned = true;
 }
 MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
 {
@@ -144,6 +163,49 @@ MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
 	}
 	return *this;
 }
+void Simplex::MyEntity::Spawn(MyPrototype* a_pPrototype, String a_sUniqueID)
+{
+	m_pPrototype = a_pPrototype;
+	//if the model is loaded
+	if (m_pPrototype != nullptr)
+	{
+		m_sUniqueID = a_sUniqueID;
+		//the instance shares the groups and meshes of the prototype, only its matrix is its own,
+		//named after the entity as that name is already unique
+		m_pModel = new Model();
+		m_pModel->Instance(m_pPrototype->m_pModel, a_sUniqueID);
+		m_pRigidBody = new MyRigidBody(*m_pPrototype->m_pRigidBody); //copy the precomputed bounds
+		m_bInMemory = true; //mark this entity as viable
+	}
+	m_pSolver = new MySolver();
+}
+MyEntity::MyPrototype* Simplex::MyEntity::GetPrototype(String a_sFileName)
+{
+	auto it = m_PrototypeMap.find(a_sFileName);
+	if (it != m_PrototypeMap.end())
+		return &it->second;
+
+	//first entity of this file, load the model and scan its vertices once
+	Model* pModel = new Model();
+	pModel->Load(a_sFileName);
+	if (pModel->GetName() == "")
+	{
+		SafeDelete(pModel);
+		return nullptr;
+	}
+
+	MyPrototype prototype;
+	prototype.m_pModel = pModel;
+	prototype.m_pRigidBody = new MyRigidBody(pModel->GetVertexList());
+	return &m_PrototypeMap.insert(std::make_pair(a_sFileName, prototype)).first->second;
+}
+void Simplex::MyEntity::ReleasePrototypes(void)
+{
+	//like the models of the entities, the prototype models are released by the mesh manager
+	for (auto it = m_PrototypeMap.begin(); it != m_PrototypeMap.end(); ++it)
+		SafeDelete(it->second.m_pRigidBody);
+	m_PrototypeMap.clear();
+}
 MyEntity::~MyEntity(){Release();}
 //--- Methods
 void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
@@ -160,28 +222,7 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 		m_pRigidBody->AddToRenderList();
 
 	if (m_bSetAxis)
-		m_pMeshMngr->AddAxisToRenderList(m_m4ToWorld);
-}
-MyEntity* Simplex::MyEntity::GetEntity(String a_sUniqueID)
-{
-	//look the entity based on the unique id
-	auto entity = m_IDMap.find(a_sUniqueID);
-	//if not found return nullptr, if found return it
-	return entity == m_IDMap.end() ? nullptr : entity->second;
-}
-void Simplex::MyEntity::GenUniqueID(String& a_sUniqueID)
-{
-	static uint index = 0;
-	String sName = a_sUniqueID;
-	MyEntity* pEntity = GetEntity(a_sUniqueID);
-	//while MyEntity exists keep changing name
-	while (pEntity)
-	{
-		a_sUniqueID = sName + "_" + std::to_string(index);
-		index++;
-		pEntity = GetEntity(a_sUniqueID);
-	}
-	return;
+		m_pMeshMngr->AddAxisToRenderList(m_Transform.GetMatrix());
 }
 void Simplex::MyEntity::AddDimension(uint a_uDimension)
 {
@@ -306,20 +347,40 @@ void Simplex::MyEntity::ApplyForce(vector3 a_v3Force)
 }
 void Simplex::MyEntity::Update(void)
 {
-	if (m_bUsePhysicsSolver)
+	if (m_bUsePhysicsSolver && m_pSolver->IsAwake())
 	{
 		m_pSolver->Update();
-		SetModelMatrix(glm::translate(m_pSolver->GetPosition()) * glm::scale(m_pSolver->GetSize()));
+		ApplySolver();
 	}
 }
-void Simplex::MyEntity::ResolveCollision(MyEntity* a_pOther)
+bool Simplex::MyEntity::ApplySolver(void)
 {
-	if (m_bUsePhysicsSolver)
-	{
-		m_pSolver->ResolveCollision(a_pOther->GetSolver());
-	}
+	if (!m_bInMemory)
+		return false;
+
+	//the solver moves the parts directly, the matrix is composed only when someone asks for it
+	m_Transform.SetPosition(m_pSolver->GetPosition());
+	m_Transform.SetScale(m_pSolver->GetSize());
+	if (m_Transform.GetChange() == TRANSFORM_NONE)
+		return false;
+
+	ApplyTransform();
+	return true;
 }
 void Simplex::MyEntity::UsePhysicsSolver(bool a_bUse)
 {
 	m_bUsePhysicsSolver = a_bUse;
+}
+void Simplex::MyEntity::SetSolver(MySolver* a_pSolver)
+{
+	if (a_pSolver == nullptr || a_pSolver == m_pSolver)
+		return;
+
+	//release the solver we were using if it was ours
+	if (m_bSolverOwned)
+	{
+		SafeDelete(m_pSolver);
+	}
+	m_pSolver = a_pSolver;
+	m_bSolverOwned = false;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@ Date: 2017/07
 #define __MYENTITY_H_
 
 #include "MySolver.h"
+#include <map>
 
 namespace Simplex
 {
@@ -13,6 +14,17 @@ namespace Simplex
 //System Class
 class MyEntity
 {
+public:
+	//Model and local bounds loaded from a file, shared by every entity spawned from it
+	struct MyPrototype
+	{
+		Model* m_pModel = nullptr; //loaded model, its instances share its groups and meshes
+		MyRigidBody* m_pRigidBody = nullptr; //rigid body holding the local bounds of the model
+	};
+
+private:
+	static std::map<String, MyPrototype> m_PrototypeMap; //prototypes by file name
+
 	bool m_bInMemory = false; //loaded flag
 	bool m_bSetAxis = false; //render axis flag
 	String m_sUniqueID = ""; //Unique identifier name
@@ -21,27 +33,35 @@ class MyEntity
 	uint* m_DimensionArray = nullptr; //Dimensions on which this entity is located
 
 	Model* m_pModel = nullptr; //Model associated with this MyEntity
+	MyPrototype* m_pPrototype = nullptr; //prototype this MyEntity was spawned from
 	MyRigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this MyEntity
 
-	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this MyEntity
+	MyTransform m_Transform; //Position, rotation and scale of this MyEntity, composes its model matrix
 	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
 
-	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
-
 	bool m_bUsePhysicsSolver = false; //Indicates if we will use a physics solver 
 
 	MySolver* m_pSolver = nullptr; //Physics MySolver
+	bool m_bSolverOwned = true; //Will this entity release its solver? (false when it lives in a manager array)
 
 public:
 	/*
 	Usage: Constructor that specifies the name attached to the MyEntity
 	Arguments:
 	-	String a_sFileName -> Name of the model to load
-	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	-	String a_sUniqueID -> Name wanted as identifier, the entity manager makes sure it is unique
 	Output: class object instance
 	*/
 	MyEntity(String a_sFileName, String a_sUniqueID = "NA");
 	/*
+	Usage: Constructor from a prototype already resolved, for spawning many entities of one file
+	Arguments:
+	-	MyPrototype* a_pPrototype -> prototype to spawn from (see GetPrototype)
+	-	String a_sUniqueID -> Name wanted as identifier, the entity manager makes sure it is unique
+	Output: class object instance
+	*/
+	MyEntity(MyPrototype* a_pPrototype, String a_sUniqueID);
+	/*
 	Usage: Copy Constructor
 	Arguments: class object to copy
 	Output: class object instance
@@ -78,6 +98,18 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld);
 	/*
+	USAGE: Gets the transform of this entity, call ApplyTransform after changing it
+	ARGUMENTS: ---
+	OUTPUT: transform
+	*/
+	MyTransform* GetTransform(void);
+	/*
+	USAGE: Passes the parts of the transform that changed to the model and the rigid body
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ApplyTransform(void);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: ---
 	OUTPUT: Model
@@ -108,18 +140,6 @@ public:
 	*/
 	bool IsColliding(MyEntity* const other);
 	/*
-	USAGE: Gets the MyEntity specified by unique ID, nullptr if not exists
-	ARGUMENTS: String a_sUniqueID -> unique ID if the queried entity
-	OUTPUT: MyEntity specified by unique ID, nullptr if not exists
-	*/
-	static MyEntity* GetEntity(String a_sUniqueID);
-	/*
-	USAGE: Will generate a unique id based on the name provided
-	ARGUMENTS: String& a_sUniqueID -> desired name
-	OUTPUT: will output though the argument
-	*/
-	void GenUniqueID(String& a_sUniqueID);
-	/*
 	USAGE: Gets the Unique ID name of this model
 	ARGUMENTS: ---
 	OUTPUT: ---
@@ -197,13 +217,6 @@ public:
 	*/
 	bool HasThisRigidBody(MyRigidBody* a_pRigidBody);
 
-	/*
-	USAGE: Asks the entity to resolve the collision with the incoming one
-	ARGUMENTS: MyEntity* a_pOther -> Queried entity
-	OUTPUT: ---
-	*/
-	void ResolveCollision(MyEntity* a_pOther);
-
 	/*
 	USAGE: Gets the solver applied to this MyEntity
 	ARGUMENTS: ---
@@ -262,11 +275,37 @@ public:
 	*/
 	void Update(void);
 	/*
+	USAGE: Moves the entity to the position and size of its solver
+	ARGUMENTS: ---
+	OUTPUT: did the entity move?
+	*/
+	bool ApplySolver(void);
+	/*
 	USAGE: Resolves using physics solver or not in the update
 	ARGUMENTS: bool a_bUse = true -> using physics solver?
 	OUTPUT: ---
 	*/
 	void UsePhysicsSolver(bool a_bUse = true);
+	/*
+	USAGE: Makes the entity use a solver stored somewhere else (like the dense solver array of
+	the entity manager), the entity will not release it
+	ARGUMENTS: MySolver* a_pSolver -> solver to use
+	OUTPUT: ---
+	*/
+	void SetSolver(MySolver* a_pSolver);
+	/*
+	USAGE: Gets the prototype of a file, loading the model and computing its bounds the first time,
+		to resolve it once when spawning many entities of the same file
+	ARGUMENTS: String a_sFileName -> name of the model
+	OUTPUT: prototype, nullptr if the model could not be loaded
+	*/
+	static MyPrototype* GetPrototype(String a_sFileName);
+	/*
+	USAGE: Releases the models and bounds loaded for spawning, call once no entity is left
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	static void ReleasePrototypes(void);
 
 private:
 	/*
@@ -281,6 +320,14 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: Makes this entity an instance of the prototype
+	Arguments:
+	-	MyPrototype* a_pPrototype -> prototype to spawn from, the entity is not viable if nullptr
+	-	String a_sUniqueID -> identifier of the entity
+	Output: ---
+	*/
+	void Spawn(MyPrototype* a_pPrototype, String a_sUniqueID);
 };//class
 
 } //namespace Simplex
@@ -1,11 +1,222 @@
 #include "MyEntityManager.h"
 using namespace Simplex;
+/*
+USAGE: Reallocates the array to the new capacity keeping the first a_uUsed entries
+ARGUMENTS:
+-	T*& a_pArray -> array to reallocate
+-	uint a_uUsed -> number of entries to keep
+-	uint a_uCapacity -> new size of the array
+OUTPUT: ---
+*/
+template <class T>
+static void ResizeArray(T*& a_pArray, uint a_uUsed, uint a_uCapacity)
+{
+	T* pTemp = new T[a_uCapacity];
+	for (uint i = 0; i < a_uUsed; ++i)
+	{
+		pTemp[i] = a_pArray[i];
+	}
+	if (a_pArray)
+	{
+		delete[] a_pArray;
+	}
+	a_pArray = pTemp;
+}
+/*
+USAGE: Time of impact of a moving box against a still one, the center of the moving box is cast
+	against the still box grown by the half size of the moving one (slab test)
+ARGUMENTS:
+-	vector3 a_v3Min -> minimum of the moving box
+-	vector3 a_v3Max -> maximum of the moving box
+-	vector3 a_v3Motion -> displacement of the moving box
+-	vector3 a_v3OtherMin -> minimum of the still box
+-	vector3 a_v3OtherMax -> maximum of the still box
+-	vector3& a_v3Normal -> (output) normal of the face hit, from the moving box to the still one
+OUTPUT: fraction of the motion at the impact, greater than 1 if they do not meet
+*/
+static float SweptTimeOfImpact(vector3 a_v3Min, vector3 a_v3Max, vector3 a_v3Motion,
+	vector3 a_v3OtherMin, vector3 a_v3OtherMax, vector3& a_v3Normal)
+{
+	vector3 v3HalfSize = (a_v3Max - a_v3Min) * 0.5f;
+	vector3 v3Center = (a_v3Max + a_v3Min) * 0.5f;
+	vector3 v3Min = a_v3OtherMin - v3HalfSize;
+	vector3 v3Max = a_v3OtherMax + v3HalfSize;
+
+	float fEnter = 0.0f;
+	float fExit = 1.0f;
+	int nAxis = -1;
+	for (int i = 0; i < 3; i++)
+	{
+		if (std::abs(a_v3Motion[i]) < 0.000001f)
+		{
+			//not moving on this axis, the center has to be between the faces already
+			if (v3Center[i] < v3Min[i] || v3Center[i] > v3Max[i])
+				return 2.0f;
+			continue;
+		}
+		float fNear = (v3Min[i] - v3Center[i]) / a_v3Motion[i];
+		float fFar = (v3Max[i] - v3Center[i]) / a_v3Motion[i];
+		if (fNear > fFar)
+			std::swap(fNear, fFar);
+		if (fNear > fEnter)
+		{
+			fEnter = fNear;
+			nAxis = i;
+		}
+		fExit = std::min(fExit, fFar);
+		if (fEnter > fExit)
+			return 2.0f;
+	}
+
+	a_v3Normal = ZERO_V3;
+	if (nAxis >= 0)
+	{
+		a_v3Normal[nAxis] = a_v3Motion[nAxis] > 0.0f ? 1.0f : -1.0f;
+		return fEnter;
+	}
+
+	//boxes touching or overlapping at the start hit right away if the motion goes into the face of least
+	//penetration, a box pushed into one it is resting against would go through it otherwise
+	float fDepth = FLT_MAX;
+	for (int i = 0; i < 3; i++)
+	{
+		float fToMin = v3Center[i] - v3Min[i];
+		float fToMax = v3Max[i] - v3Center[i];
+		if (std::min(fToMin, fToMax) < fDepth)
+		{
+			fDepth = std::min(fToMin, fToMax);
+			nAxis = i;
+		}
+	}
+	a_v3Normal[nAxis] = v3Center[nAxis] - v3Min[nAxis] < v3Max[nAxis] - v3Center[nAxis] ? 1.0f : -1.0f;
+	if (glm::dot(a_v3Motion, a_v3Normal) > 0.0f)
+		return 0.0f;
+	return 2.0f;
+}
+/*
+USAGE: Writes a contact field by field, padding never reaches the snapshot
+ARGUMENTS:
+-	MySnapshot& a_Snapshot -> snapshot to write to
+-	MyContact const& a_Contact -> contact to write
+OUTPUT: ---
+*/
+static void WriteContact(MySnapshot& a_Snapshot, MyContact const& a_Contact)
+{
+	a_Snapshot.Write(a_Contact.m_hEntityA.m_uSlot);
+	a_Snapshot.Write(a_Contact.m_hEntityA.m_uGeneration);
+	a_Snapshot.Write(a_Contact.m_hEntityB.m_uSlot);
+	a_Snapshot.Write(a_Contact.m_hEntityB.m_uGeneration);
+	a_Snapshot.Write(a_Contact.m_uIndexA);
+	a_Snapshot.Write(a_Contact.m_uIndexB);
+	a_Snapshot.Write(a_Contact.m_fInverseMassA);
+	a_Snapshot.Write(a_Contact.m_fInverseMassB);
+	a_Snapshot.Write(a_Contact.m_v3Normal);
+	a_Snapshot.Write(a_Contact.m_fPenetration);
+	a_Snapshot.Write(a_Contact.m_fNormalImpulse);
+	a_Snapshot.Write(a_Contact.m_fPushImpulse);
+	a_Snapshot.Write(a_Contact.m_v3TangentImpulse);
+	a_Snapshot.Write(a_Contact.m_uFrame);
+}
+/*
+USAGE: Reads a contact written by WriteContact
+ARGUMENTS:
+-	MySnapshot& a_Snapshot -> snapshot to read from
+-	MyContact& a_Contact -> (output) contact read
+OUTPUT: was there enough data?
+*/
+static bool ReadContact(MySnapshot& a_Snapshot, MyContact& a_Contact)
+{
+	return a_Snapshot.Read(a_Contact.m_hEntityA.m_uSlot) &&
+		a_Snapshot.Read(a_Contact.m_hEntityA.m_uGeneration) &&
+		a_Snapshot.Read(a_Contact.m_hEntityB.m_uSlot) &&
+		a_Snapshot.Read(a_Contact.m_hEntityB.m_uGeneration) &&
+		a_Snapshot.Read(a_Contact.m_uIndexA) &&
+		a_Snapshot.Read(a_Contact.m_uIndexB) &&
+		a_Snapshot.Read(a_Contact.m_fInverseMassA) &&
+		a_Snapshot.Read(a_Contact.m_fInverseMassB) &&
+		a_Snapshot.Read(a_Contact.m_v3Normal) &&
+		a_Snapshot.Read(a_Contact.m_fPenetration) &&
+		a_Snapshot.Read(a_Contact.m_fNormalImpulse) &&
+		a_Snapshot.Read(a_Contact.m_fPushImpulse) &&
+		a_Snapshot.Read(a_Contact.m_v3TangentImpulse) &&
+		a_Snapshot.Read(a_Contact.m_uFrame);
+}
+/*
+USAGE: Writes an input field by field, the type goes as a uint so the size of the enum does not matter
+ARGUMENTS:
+-	MySnapshot& a_Snapshot -> snapshot to write to
+-	MyInput const& a_Input -> input to write
+OUTPUT: ---
+*/
+static void WriteInput(MySnapshot& a_Snapshot, MyInput const& a_Input)
+{
+	a_Snapshot.Write(a_Input.m_uFrame);
+	a_Snapshot.Write(a_Input.m_hEntity.m_uSlot);
+	a_Snapshot.Write(a_Input.m_hEntity.m_uGeneration);
+	a_Snapshot.Write(static_cast<uint>(a_Input.m_eType));
+	a_Snapshot.Write(a_Input.m_v3Value);
+}
+/*
+USAGE: Reads an input written by WriteInput
+ARGUMENTS:
+-	MySnapshot& a_Snapshot -> snapshot to read from
+-	MyInput& a_Input -> (output) input read
+OUTPUT: was there enough data and is the type known?
+*/
+static bool ReadInput(MySnapshot& a_Snapshot, MyInput& a_Input)
+{
+	uint uType = 0;
+	if (!a_Snapshot.Read(a_Input.m_uFrame) ||
+		!a_Snapshot.Read(a_Input.m_hEntity.m_uSlot) ||
+		!a_Snapshot.Read(a_Input.m_hEntity.m_uGeneration) ||
+		!a_Snapshot.Read(uType) || uType > INPUT_POSITION ||
+		!a_Snapshot.Read(a_Input.m_v3Value))
+		return false;
+	a_Input.m_eType = static_cast<eINPUT>(uType);
+	return true;
+}
 //  MyEntityManager
 Simplex::MyEntityManager* Simplex::MyEntityManager::m_pInstance = nullptr;
 void Simplex::MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
+	m_uCapacity = 0;
 	m_mEntityArray = nullptr;
+
+	m_m4ToWorldArray = nullptr;
+	m_v3MinGArray = nullptr;
+	m_v3MaxGArray = nullptr;
+	m_pSolverArray = nullptr;
+	m_bPhysicsArray = nullptr;
+	m_uIslandIDArray = nullptr;
+
+	m_uAwakeArray = nullptr;
+	m_uAwakeCount = 0;
+	m_bAwakeArray = nullptr;
+
+	m_uIslandArray = nullptr;
+	m_bIslandRestArray = nullptr;
+	m_uIslandCount = 0;
+	m_IslandMap.clear();
+
+	m_uSlotArray = nullptr;
+	m_uGenerationArray = nullptr;
+	m_uDenseSlotArray = nullptr;
+	m_uSlotCount = 0;
+	m_uFreeSlot = -1;
+	m_IDHandleMap.clear();
+
+	m_ContactMap.clear();
+	m_ContactList.clear();
+	m_SleepingContactMap.clear();
+	m_uContactFrame = 0;
+	m_uFrame = 0;
+
+	m_InputLog.clear();
+	m_bRecording = false;
+	m_bReplaying = false;
+	m_uReplayInput = 0;
+	m_uLogFrame = 0;
 }
 void Simplex::MyEntityManager::Release(void)
 {
@@ -15,7 +226,100 @@ void Simplex::MyEntityManager::Release(void)
 		SafeDelete(pEntity);
 	}
 	m_uEntityCount = 0;
-	m_mEntityArray = nullptr;
+	m_uCapacity = 0;
+
+	//the entities are gone so we can release the arrays
+	if (m_mEntityArray) { delete[] m_mEntityArray; m_mEntityArray = nullptr; }
+	if (m_m4ToWorldArray) { delete[] m_m4ToWorldArray; m_m4ToWorldArray = nullptr; }
+	if (m_v3MinGArray) { delete[] m_v3MinGArray; m_v3MinGArray = nullptr; }
+	if (m_v3MaxGArray) { delete[] m_v3MaxGArray; m_v3MaxGArray = nullptr; }
+	if (m_pSolverArray) { delete[] m_pSolverArray; m_pSolverArray = nullptr; }
+	if (m_bPhysicsArray) { delete[] m_bPhysicsArray; m_bPhysicsArray = nullptr; }
+	if (m_uIslandIDArray) { delete[] m_uIslandIDArray; m_uIslandIDArray = nullptr; }
+	if (m_uAwakeArray) { delete[] m_uAwakeArray; m_uAwakeArray = nullptr; }
+	if (m_bAwakeArray) { delete[] m_bAwakeArray; m_bAwakeArray = nullptr; }
+	if (m_uIslandArray) { delete[] m_uIslandArray; m_uIslandArray = nullptr; }
+	if (m_bIslandRestArray) { delete[] m_bIslandRestArray; m_bIslandRestArray = nullptr; }
+	m_IslandMap.clear();
+	m_uAwakeCount = 0;
+	if (m_uSlotArray) { delete[] m_uSlotArray; m_uSlotArray = nullptr; }
+	if (m_uGenerationArray) { delete[] m_uGenerationArray; m_uGenerationArray = nullptr; }
+	if (m_uDenseSlotArray) { delete[] m_uDenseSlotArray; m_uDenseSlotArray = nullptr; }
+
+	m_uSlotCount = 0;
+	m_uFreeSlot = -1;
+	m_IDHandleMap.clear();
+
+	m_ContactMap.clear();
+	m_ContactList.clear();
+	m_SleepingContactMap.clear();
+	m_uContactFrame = 0;
+	m_InputLog.clear();
+
+	//no entity is left to instance the prototypes
+	MyEntity::ReleasePrototypes();
+}
+void Simplex::MyEntityManager::Reserve(uint a_uCapacity)
+{
+	//we never shrink the arrays
+	if (a_uCapacity <= m_uCapacity)
+		return;
+
+	ResizeArray(m_mEntityArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_m4ToWorldArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_v3MinGArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_v3MaxGArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_pSolverArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_bPhysicsArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_uIslandIDArray, m_uEntityCount, a_uCapacity);
+	ResizeArray(m_uAwakeArray, m_uAwakeCount, a_uCapacity);
+	ResizeArray(m_bAwakeArray, m_uEntityCount, a_uCapacity);
+	//island scratch is rebuilt every frame, nothing to keep
+	ResizeArray(m_uIslandArray, 0, a_uCapacity);
+	ResizeArray(m_bIslandRestArray, 0, a_uCapacity);
+	ResizeArray(m_uDenseSlotArray, m_uEntityCount, a_uCapacity);
+	//slots are only issued when all the others are in use so they always fit in the capacity
+	ResizeArray(m_uSlotArray, m_uSlotCount, a_uCapacity);
+	ResizeArray(m_uGenerationArray, m_uSlotCount, a_uCapacity);
+
+	m_uCapacity = a_uCapacity;
+
+	//the solvers moved, let the entities know
+	LinkSolvers();
+}
+void Simplex::MyEntityManager::LinkSolvers(void)
+{
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		m_mEntityArray[i]->SetSolver(&m_pSolverArray[i]);
+	}
+}
+void Simplex::MyEntityManager::SyncComponents(uint a_uIndex)
+{
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+	MyRigidBody* pRigidBody = pEntity->GetRigidBody();
+	m_m4ToWorldArray[a_uIndex] = pEntity->GetModelMatrix();
+	m_v3MinGArray[a_uIndex] = pRigidBody->GetMinGlobal();
+	m_v3MaxGArray[a_uIndex] = pRigidBody->GetMaxGlobal();
+}
+bool Simplex::MyEntityManager::IsAwake(uint a_uIndex)
+{
+	return m_bPhysicsArray[a_uIndex] && m_pSolverArray[a_uIndex].IsAwake();
+}
+bool Simplex::MyEntityManager::IsSleeping(uint a_uIndex)
+{
+	return m_bPhysicsArray[a_uIndex] && !m_pSolverArray[a_uIndex].IsAwake();
+}
+void Simplex::MyEntityManager::ClearCollisions(uint a_uIndex)
+{
+	MyRigidBody* pRigidBody = m_mEntityArray[a_uIndex]->GetRigidBody();
+	MyRigidBody::PRigidBody* pColliderArray = pRigidBody->GetColliderArray();
+	uint uColliderCount = pRigidBody->GetCollidingCount();
+	for (uint i = 0; i < uColliderCount; ++i)
+	{
+		pColliderArray[i]->RemoveCollisionWith(pRigidBody);
+	}
+	pRigidBody->ClearCollidingList();
 }
 Simplex::MyEntityManager* Simplex::MyEntityManager::GetInstance()
 {
@@ -35,17 +339,57 @@ void Simplex::MyEntityManager::ReleaseInstance()
 }
 int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 {
-	//look one by one for the specified unique id
-	for (uint uIndex = 0; uIndex < m_uEntityCount; ++uIndex)
+	//the hash index gives us the handle and the handle the position in the list
+	return GetEntityIndex(GetEntityHandle(a_sUniqueID));
+}
+int Simplex::MyEntityManager::GetEntityIndex(MyEntityHandle a_hEntity)
+{
+	if (!IsValidHandle(a_hEntity))
+		return -1;
+	return m_uSlotArray[a_hEntity.m_uSlot];
+}
+bool Simplex::MyEntityManager::IsValidHandle(MyEntityHandle a_hEntity)
+{
+	//the slot needs to exist and not have been released since the handle was issued
+	if (a_hEntity.m_uSlot >= m_uSlotCount)
+		return false;
+	return m_uGenerationArray[a_hEntity.m_uSlot] == a_hEntity.m_uGeneration;
+}
+Simplex::MyEntityHandle Simplex::MyEntityManager::GetEntityHandle(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return MyEntityHandle();
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	uint uSlot = m_uDenseSlotArray[a_uIndex];
+	return MyEntityHandle(uSlot, m_uGenerationArray[uSlot]);
+}
+Simplex::MyEntityHandle Simplex::MyEntityManager::GetEntityHandle(String a_sUniqueID)
+{
+	auto handle = m_IDHandleMap.find(a_sUniqueID);
+	//if not found return an invalid handle
+	return handle == m_IDHandleMap.end() ? MyEntityHandle() : handle->second;
+}
+void Simplex::MyEntityManager::GenUniqueID(String& a_sUniqueID)
+{
+	static uint index = 0;
+	String sName = a_sUniqueID;
+	//while the name is taken keep changing it
+	while (m_IDHandleMap.find(a_sUniqueID) != m_IDHandleMap.end())
 	{
-		if (a_sUniqueID == m_mEntityArray[uIndex]->GetUniqueID())
-			return uIndex;
+		a_sUniqueID = sName + "_" + std::to_string(index);
+		index++;
 	}
-	//if not found return -1
-	return -1;
 }
 //Accessors
 Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_uEntityCount; }
+Simplex::uint Simplex::MyEntityManager::GetAwakeCount(void) { return m_uAwakeCount; }
+Simplex::uint Simplex::MyEntityManager::GetContactCount(void) { return static_cast<uint>(m_ContactList.size()); }
+Simplex::uint Simplex::MyEntityManager::GetFrame(void) { return m_uFrame; }
 Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 {
 	//if the list is empty return
@@ -61,7 +405,7 @@ Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 Simplex::Model* Simplex::MyEntityManager::GetModel(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -84,7 +428,7 @@ Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(uint a_uIndex)
 Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -104,10 +448,19 @@ Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(uint a_uIndex)
 
 	return m_mEntityArray[a_uIndex]->GetModelMatrix();
 }
+Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(MyEntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity does not exist return
+	if (nIndex < 0)
+		return IDENTITY_M4;
+
+	return m_m4ToWorldArray[nIndex];
+}
 Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -115,14 +468,23 @@ Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 	}
 	return IDENTITY_M4;
 }
+void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, MyEntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity exists
+	if (nIndex >= 0)
+	{
+		SetModelMatrix(a_m4ToWorld, (uint)nIndex);
+	}
+}
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetModelMatrix(a_m4ToWorld);
+		SetModelMatrix(a_m4ToWorld, (uint)nIndex);
 	}
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uIndex)
@@ -140,7 +502,7 @@ void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uInd
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -158,6 +520,7 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex
 		a_uIndex = m_uEntityCount - 1;
 
 	m_mEntityArray[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+	SyncComponents(a_uIndex);
 }
 //The big 3
 Simplex::MyEntityManager::MyEntityManager(){Init();}
@@ -167,55 +530,580 @@ Simplex::MyEntityManager::~MyEntityManager(){Release();};
 // other methods
 void Simplex::MyEntityManager::Update(void)
 {
-	//Clear all collisions
+	++m_uFrame;
+
+	//while replaying the inputs of this frame come from the log, as they were given when it was recorded
+	if (m_bReplaying)
+	{
+		while (m_uReplayInput < m_InputLog.size() && m_InputLog[m_uReplayInput].m_uFrame <= m_uFrame)
+		{
+			ApplyInput(m_InputLog[m_uReplayInput]);
+			++m_uReplayInput;
+		}
+		if (m_uFrame >= m_uLogFrame)
+			m_bReplaying = false;
+	}
+	else if (m_bRecording)
+		m_uLogFrame = m_uFrame;
+
+	//list the entities that are moving, the rest of the frame only walks this list
+	m_uAwakeCount = 0;
+	m_bVelocityDone = false;
 	for (uint i = 0; i < m_uEntityCount; i++)
 	{
-		m_mEntityArray[i]->ClearCollisionList();
+		m_bAwakeArray[i] = false;
 	}
-	
-	//check collisions
 	for (uint i = 0; i < m_uEntityCount; i++)
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		if (!IsAwake(i) || m_bAwakeArray[i])
+			continue;
+		//an entity woken up from outside (forces, positions) wakes up the island it was sleeping with
+		WakeIsland(i);
+	}
+
+	//Clear the collisions and refresh the dense bounds in case entities were moved from outside,
+	//sleeping and static entities keep their collisions as they only change when something awake moves
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		uint i = m_uAwakeArray[uAwake];
+		ClearCollisions(i);
+		SyncComponents(i);
+	}
+
+	//forces first, so the contacts work with the velocity the entities want to move with
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		m_pSolverArray[m_uAwakeArray[uAwake]].IntegrateVelocity();
+	}
+	m_bVelocityDone = true;
+	
+	//check collisions, only pairs with an awake entity can start or stop touching
+	m_ContactList.clear();
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		uint i = m_uAwakeArray[uAwake];
+		vector3 v3MinI = m_v3MinGArray[i];
+		vector3 v3MaxI = m_v3MaxGArray[i];
+		for (uint j = 0; j < m_uEntityCount; j++)
 		{
-			//if objects are colliding resolve the collision
+			//pairs of awake entities are checked once, from the lowest index
+			if (j == i || (m_bAwakeArray[j] && j < i))
+				continue;
+
+			//reject with the dense bounds first so separated pairs never touch the entities
+			if (v3MaxI.x < m_v3MinGArray[j].x || v3MinI.x > m_v3MaxGArray[j].x ||
+				v3MaxI.y < m_v3MinGArray[j].y || v3MinI.y > m_v3MaxGArray[j].y ||
+				v3MaxI.z < m_v3MinGArray[j].z || v3MinI.z > m_v3MaxGArray[j].z)
+				continue;
+
+			//if objects are colliding keep track of their contact
 			if (m_mEntityArray[i]->IsColliding(m_mEntityArray[j]))
 			{
-				m_mEntityArray[i]->ResolveCollision(m_mEntityArray[j]);
+				UpdateContact(i, j);
+			}
+		}
+	}
+
+	SolveContacts();
+
+	//integrate the awake entities, including the ones woken up by a contact this frame, the fast ones
+	//are swept so they stop at what they hit instead of going through it
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		uint i = m_uAwakeArray[uAwake];
+		if (IsFast(i))
+		{
+			SweepEntity(i);
+			continue;
+		}
+		m_pSolverArray[i].IntegratePosition();
+		//entities at rest keep their matrix and bounds
+		if (m_mEntityArray[i]->ApplySolver())
+			SyncComponents(i);
+	}
+
+	UpdateIslands();
+	PruneContacts();
+	m_bVelocityDone = false;
+}
+bool Simplex::MyEntityManager::IsFast(uint a_uIndex)
+{
+	vector3 v3Size = m_v3MaxGArray[a_uIndex] - m_v3MinGArray[a_uIndex];
+	float fExtent = std::min(v3Size.x, std::min(v3Size.y, v3Size.z));
+	return glm::length(m_pSolverArray[a_uIndex].GetVelocity()) > fExtent * CCD_THRESHOLD;
+}
+void Simplex::MyEntityManager::SweepEntity(uint a_uIndex)
+{
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+	MySolver& solver = m_pSolverArray[a_uIndex];
+	float fTimeLeft = 1.0f;
+	for (uint uStep = 0; uStep < CCD_MAX_STEPS; uStep++)
+	{
+		//the push only takes out penetration so it is too small to tunnel, only the velocity is swept
+		float fHit = 1.0f;
+		vector3 v3Normal;
+		int nHit = FindSweepHit(a_uIndex, solver.GetVelocity() * fTimeLeft, fHit, v3Normal);
+
+		//move up to the impact, or all the way if there is none
+		solver.IntegratePosition(fTimeLeft * fHit);
+		if (pEntity->ApplySolver())
+			SyncComponents(a_uIndex);
+		if (nHit < 0)
+			return;
+		fTimeLeft *= 1.0f - fHit;
+
+		//inelastic impact, a sleeping entity is woken up to take its share
+		uint j = static_cast<uint>(nHit);
+		if (IsSleeping(j))
+			WakeIsland(j);
+		MySolver& other = m_pSolverArray[j];
+		float fInverseMassOther = IsAwake(j) ? other.GetInverseMass() : 0.0f;
+		vector3 v3VelocityOther = IsAwake(j) ? other.GetVelocity() : ZERO_V3;
+		float fApproach = glm::dot(solver.GetVelocity() - v3VelocityOther, v3Normal);
+		if (fApproach > 0.0f)
+		{
+			vector3 v3Impulse = v3Normal * (fApproach / (solver.GetInverseMass() + fInverseMassOther));
+			solver.ApplyImpulse(-v3Impulse);
+			if (fInverseMassOther > 0.0f)
+				other.ApplyImpulse(v3Impulse);
+		}
+	}
+	//out of substeps, the rest of the frame still moves up to what is in the way, an entity pushing
+	//another one ahead of it stops at it instead of going through before the other one moved
+	float fHit = 1.0f;
+	vector3 v3Normal;
+	FindSweepHit(a_uIndex, solver.GetVelocity() * fTimeLeft, fHit, v3Normal);
+	solver.IntegratePosition(fTimeLeft * fHit);
+	if (pEntity->ApplySolver())
+		SyncComponents(a_uIndex);
+}
+int Simplex::MyEntityManager::FindSweepHit(uint a_uIndex, vector3 a_v3Motion, float& a_fTime, vector3& a_v3Normal)
+{
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+	vector3 v3Min = m_v3MinGArray[a_uIndex];
+	vector3 v3Max = m_v3MaxGArray[a_uIndex];
+	vector3 v3SweptMin = glm::min(v3Min, v3Min + a_v3Motion);
+	vector3 v3SweptMax = glm::max(v3Max, v3Max + a_v3Motion);
+
+	a_fTime = 1.0f;
+	int nHit = -1;
+	for (uint j = 0; j < m_uEntityCount; j++)
+	{
+		if (j == a_uIndex)
+			continue;
+
+		//entities outside of the box covering the whole motion cannot be hit
+		if (v3SweptMax.x < m_v3MinGArray[j].x || v3SweptMin.x > m_v3MaxGArray[j].x ||
+			v3SweptMax.y < m_v3MinGArray[j].y || v3SweptMin.y > m_v3MaxGArray[j].y ||
+			v3SweptMax.z < m_v3MinGArray[j].z || v3SweptMin.z > m_v3MaxGArray[j].z)
+			continue;
+
+		if (!pEntity->SharesDimension(m_mEntityArray[j]))
+			continue;
+
+		vector3 v3HitNormal;
+		float fTime = SweptTimeOfImpact(v3Min, v3Max, a_v3Motion, m_v3MinGArray[j], m_v3MaxGArray[j], v3HitNormal);
+		if (fTime < a_fTime)
+		{
+			a_fTime = fTime;
+			nHit = j;
+			a_v3Normal = v3HitNormal;
+		}
+	}
+	return nHit;
+}
+void Simplex::MyEntityManager::WakeIsland(uint a_uIndex)
+{
+	uint uIslandID = m_uIslandIDArray[a_uIndex];
+	//an entity that never slept with an island only wakes itself up
+	auto island = m_IslandMap.find(uIslandID);
+	if (uIslandID == 0 || island == m_IslandMap.end())
+	{
+		WakeEntity(a_uIndex);
+		return;
+	}
+
+	//removed entities left stale handles behind and the ones woken up on their own left the island
+	std::vector<uint> indexList;
+	std::vector<MyEntityHandle>& entityList = island->second.m_EntityList;
+	for (uint i = 0; i < entityList.size(); i++)
+	{
+		int nIndex = GetEntityIndex(entityList[i]);
+		if (nIndex >= 0 && m_uIslandIDArray[nIndex] == uIslandID)
+			indexList.push_back(static_cast<uint>(nIndex));
+	}
+
+	//its contacts go back to the live map as touching the last time the contacts were pruned so they
+	//warm start, the ones shared with another island that woke up first are already back
+	std::vector<unsigned long long>& keyList = island->second.m_ContactKeyList;
+	for (uint i = 0; i < keyList.size(); i++)
+	{
+		auto contact = m_SleepingContactMap.find(keyList[i]);
+		if (contact == m_SleepingContactMap.end())
+			continue;
+		contact->second.m_uFrame = m_uContactFrame;
+		//a pair found again while parked keeps the contact it was given
+		m_ContactMap.emplace(contact->first, contact->second);
+		m_SleepingContactMap.erase(contact);
+	}
+	m_IslandMap.erase(island);
+
+	//in index order, so the awake list is the same whether the island was built live or read from a snapshot
+	std::sort(indexList.begin(), indexList.end());
+	for (uint i = 0; i < indexList.size(); i++)
+	{
+		WakeEntity(indexList[i]);
+	}
+	WakeEntity(a_uIndex);
+}
+void Simplex::MyEntityManager::WakeEntity(uint a_uIndex)
+{
+	m_uIslandIDArray[a_uIndex] = 0;
+	//waking an awake solver would restart the frames it has been resting
+	if (!m_pSolverArray[a_uIndex].IsAwake())
+		m_pSolverArray[a_uIndex].Wake();
+	if (m_bAwakeArray[a_uIndex])
+		return;
+	m_bAwakeArray[a_uIndex] = true;
+	m_uAwakeArray[m_uAwakeCount] = a_uIndex;
+	++m_uAwakeCount;
+	//woken up by a contact or a sweep, it still gets the forces of this frame before it is solved
+	if (m_bVelocityDone)
+		m_pSolverArray[a_uIndex].IntegrateVelocity();
+}
+Simplex::uint Simplex::MyEntityManager::FindIsland(uint a_uIndex)
+{
+	while (m_uIslandArray[a_uIndex] != a_uIndex)
+	{
+		m_uIslandArray[a_uIndex] = m_uIslandArray[m_uIslandArray[a_uIndex]];
+		a_uIndex = m_uIslandArray[a_uIndex];
+	}
+	return a_uIndex;
+}
+void Simplex::MyEntityManager::UpdateIslands(void)
+{
+	//every awake entity starts as an island of its own
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		uint i = m_uAwakeArray[uAwake];
+		m_uIslandArray[i] = i;
+		m_bIslandRestArray[i] = true;
+	}
+
+	//the contacts join them, static and sleeping entities do not carry an island through them
+	uint uContactCount = static_cast<uint>(m_ContactList.size());
+	for (uint i = 0; i < uContactCount; ++i)
+	{
+		MyContact& contact = *m_ContactList[i];
+		if (!m_bAwakeArray[contact.m_uIndexA] || !m_bAwakeArray[contact.m_uIndexB])
+			continue;
+		uint uRootA = FindIsland(contact.m_uIndexA);
+		uint uRootB = FindIsland(contact.m_uIndexB);
+		if (uRootA != uRootB)
+			m_uIslandArray[uRootA] = uRootB;
+	}
+
+	//one entity that is still moving keeps its whole island awake
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		uint i = m_uAwakeArray[uAwake];
+		if (!m_pSolverArray[i].CanSleep())
+			m_bIslandRestArray[FindIsland(i)] = false;
+	}
+
+	for (uint uAwake = 0; uAwake < m_uAwakeCount; uAwake++)
+	{
+		uint i = m_uAwakeArray[uAwake];
+		uint uRoot = FindIsland(i);
+		if (!m_bIslandRestArray[uRoot])
+			continue;
+		//the root names the island for the rest of its entities
+		if (m_uIslandIDArray[uRoot] == 0)
+		{
+			++m_uIslandCount;
+			m_uIslandIDArray[uRoot] = m_uIslandCount;
+		}
+		m_uIslandIDArray[i] = m_uIslandIDArray[uRoot];
+		m_pSolverArray[i].Sleep();
+		uint uSlot = m_uDenseSlotArray[i];
+		m_IslandMap[m_uIslandIDArray[i]].m_EntityList.push_back(MyEntityHandle(uSlot, m_uGenerationArray[uSlot]));
+	}
+}
+void Simplex::MyEntityManager::UpdateContact(uint a_uIndexA, uint a_uIndexB)
+{
+	//contacts only matter if one of the entities can move
+	bool bAwakeA = IsAwake(a_uIndexA);
+	bool bAwakeB = IsAwake(a_uIndexB);
+	if (!bAwakeA && !bAwakeB)
+		return;
+
+	//a sleeping entity only wakes up when something lands on it or pushes it, an entity resting on
+	//top of it treats it as static, otherwise both would keep waking each other up
+	if (!bAwakeA && IsSleeping(a_uIndexA) && !m_pSolverArray[a_uIndexB].IsResting())
+		WakeIsland(a_uIndexA);
+	if (!bAwakeB && IsSleeping(a_uIndexB) && !m_pSolverArray[a_uIndexA].IsResting())
+		WakeIsland(a_uIndexB);
+
+	//order the pair by slot so the key and the direction of the normal do not depend on the order of the list
+	if (m_uDenseSlotArray[a_uIndexA] > m_uDenseSlotArray[a_uIndexB])
+		std::swap(a_uIndexA, a_uIndexB);
+	uint uSlotA = m_uDenseSlotArray[a_uIndexA];
+	uint uSlotB = m_uDenseSlotArray[a_uIndexB];
+
+	vector3 v3Normal;
+	float fPenetration;
+	MyRigidBody* pRigidBodyA = m_mEntityArray[a_uIndexA]->GetRigidBody();
+	if (!pRigidBodyA->GetContact(m_mEntityArray[a_uIndexB]->GetRigidBody(), v3Normal, fPenetration))
+		return;
+
+	unsigned long long uKey = (static_cast<unsigned long long>(uSlotA) << 32) | uSlotB;
+	MyContact& contact = m_ContactMap[uKey];
+	//an entity woken up during the broadphase can reach a pair that was already gathered
+	if (contact.m_uFrame == m_uFrame)
+		return;
+	MyEntityHandle hEntityA(uSlotA, m_uGenerationArray[uSlotA]);
+	MyEntityHandle hEntityB(uSlotB, m_uGenerationArray[uSlotB]);
+
+	//the impulses are only a good guess if the same pair was touching last frame along the same face
+	bool bPersistent = contact.m_uFrame + 1 == m_uFrame &&
+		contact.m_hEntityA.m_uSlot == hEntityA.m_uSlot && contact.m_hEntityA.m_uGeneration == hEntityA.m_uGeneration &&
+		contact.m_hEntityB.m_uSlot == hEntityB.m_uSlot && contact.m_hEntityB.m_uGeneration == hEntityB.m_uGeneration &&
+		glm::dot(contact.m_v3Normal, v3Normal) > 0.95f;
+	if (!bPersistent)
+	{
+		contact.m_fNormalImpulse = 0.0f;
+		contact.m_v3TangentImpulse = ZERO_V3;
+	}
+	contact.m_fPushImpulse = 0.0f;
+
+	contact.m_hEntityA = hEntityA;
+	contact.m_hEntityB = hEntityB;
+	contact.m_uIndexA = a_uIndexA;
+	contact.m_uIndexB = a_uIndexB;
+	//static and sleeping entities do not move, they take any impulse
+	contact.m_fInverseMassA = IsAwake(a_uIndexA) ? m_pSolverArray[a_uIndexA].GetInverseMass() : 0.0f;
+	contact.m_fInverseMassB = IsAwake(a_uIndexB) ? m_pSolverArray[a_uIndexB].GetInverseMass() : 0.0f;
+	contact.m_v3Normal = v3Normal;
+	contact.m_fPenetration = fPenetration;
+	contact.m_uFrame = m_uFrame;
+	m_ContactList.push_back(&contact);
+}
+void Simplex::MyEntityManager::SolveContacts(void)
+{
+	uint uContactCount = static_cast<uint>(m_ContactList.size());
+
+	//warm start, for a resting stack the impulses of last frame are most of the answer
+	for (uint i = 0; i < uContactCount; ++i)
+	{
+		MyContact& contact = *m_ContactList[i];
+		vector3 v3Impulse = contact.m_v3Normal * contact.m_fNormalImpulse + contact.m_v3TangentImpulse;
+		if (contact.m_fInverseMassA > 0.0f)
+		{
+			m_pSolverArray[contact.m_uIndexA].ApplyImpulse(-v3Impulse);
+			m_pSolverArray[contact.m_uIndexA].SolveFloor();
+		}
+		if (contact.m_fInverseMassB > 0.0f)
+		{
+			m_pSolverArray[contact.m_uIndexB].ApplyImpulse(v3Impulse);
+			m_pSolverArray[contact.m_uIndexB].SolveFloor();
+		}
+	}
+
+	for (uint uIteration = 0; uIteration < CONTACT_ITERATIONS; ++uIteration)
+	{
+		for (uint i = 0; i < uContactCount; ++i)
+		{
+			MyContact& contact = *m_ContactList[i];
+			MySolver& solverA = m_pSolverArray[contact.m_uIndexA];
+			MySolver& solverB = m_pSolverArray[contact.m_uIndexB];
+			float fInverseMass = contact.m_fInverseMassA + contact.m_fInverseMassB;
+
+			//normal, the entities cannot keep moving into each other
+			vector3 v3Relative = solverB.GetVelocity() - solverA.GetVelocity();
+			float fLambda = -glm::dot(v3Relative, contact.m_v3Normal) / fInverseMass;
+			//the accumulated impulse can only push, clamping the total and not the step lets it correct itself
+			float fOldImpulse = contact.m_fNormalImpulse;
+			contact.m_fNormalImpulse = std::max(fOldImpulse + fLambda, 0.0f);
+			vector3 v3Impulse = contact.m_v3Normal * (contact.m_fNormalImpulse - fOldImpulse);
+
+			//friction, cancels the sliding up to what the normal impulse allows
+			v3Relative += v3Impulse * fInverseMass;
+			vector3 v3Sliding = v3Relative - contact.m_v3Normal * glm::dot(v3Relative, contact.m_v3Normal);
+			vector3 v3OldTangent = contact.m_v3TangentImpulse;
+			vector3 v3Tangent = v3OldTangent - v3Sliding / fInverseMass;
+			float fMaxFriction = CONTACT_FRICTION * contact.m_fNormalImpulse;
+			float fFriction = glm::length(v3Tangent);
+			if (fFriction > fMaxFriction)
+				v3Tangent *= fMaxFriction / fFriction;
+			contact.m_v3TangentImpulse = v3Tangent;
+			v3Impulse += v3Tangent - v3OldTangent;
+
+			//split impulse, the penetration past the slop is pushed out with a velocity that is not kept
+			vector3 v3RelativePush = solverB.GetPush() - solverA.GetPush();
+			float fBias = CONTACT_CORRECTION * std::max(contact.m_fPenetration - CONTACT_SLOP, 0.0f);
+			float fPushLambda = (fBias - glm::dot(v3RelativePush, contact.m_v3Normal)) / fInverseMass;
+			float fOldPush = contact.m_fPushImpulse;
+			contact.m_fPushImpulse = std::max(fOldPush + fPushLambda, 0.0f);
+			vector3 v3Push = contact.m_v3Normal * (contact.m_fPushImpulse - fOldPush);
+
+			//the floor is one more contact, solved right after the impulses that could push into it
+			if (contact.m_fInverseMassA > 0.0f)
+			{
+				solverA.ApplyImpulse(-v3Impulse);
+				solverA.ApplyPushImpulse(-v3Push);
+				solverA.SolveFloor();
+			}
+			if (contact.m_fInverseMassB > 0.0f)
+			{
+				solverB.ApplyImpulse(v3Impulse);
+				solverB.ApplyPushImpulse(v3Push);
+				solverB.SolveFloor();
 			}
 		}
-		//Update each entity
-		m_mEntityArray[i]->Update();
 	}
 }
+void Simplex::MyEntityManager::PruneContacts(void)
+{
+	//the list of this frame points into the map, it lets go of the contacts about to be parked first
+	uint uKept = 0;
+	for (uint i = 0; i < m_ContactList.size(); i++)
+	{
+		MyContact* pContact = m_ContactList[i];
+		if (!IsSleeping(pContact->m_uIndexA) || !IsSleeping(pContact->m_uIndexB))
+			m_ContactList[uKept++] = pContact;
+	}
+	m_ContactList.resize(uKept);
+
+	//only awake contacts are here, the indices of the ones found this frame are still good
+	for (auto contact = m_ContactMap.begin(); contact != m_ContactMap.end();)
+	{
+		MyContact& current = contact->second;
+		if (current.m_uFrame != m_uFrame)
+		{
+			contact = m_ContactMap.erase(contact);
+			continue;
+		}
+		//a pair that fell asleep touching is still touching, it waits with its islands until one wakes up
+		if (IsSleeping(current.m_uIndexA) && IsSleeping(current.m_uIndexB))
+		{
+			uint uIslandA = m_uIslandIDArray[current.m_uIndexA];
+			uint uIslandB = m_uIslandIDArray[current.m_uIndexB];
+			m_IslandMap[uIslandA].m_ContactKeyList.push_back(contact->first);
+			if (uIslandB != uIslandA)
+				m_IslandMap[uIslandB].m_ContactKeyList.push_back(contact->first);
+			m_SleepingContactMap[contact->first] = current;
+			contact = m_ContactMap.erase(contact);
+			continue;
+		}
+		++contact;
+	}
+	m_uContactFrame = m_uFrame;
+}
 void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
 {
+	//make sure the identifier is not taken
+	GenUniqueID(a_sUniqueID);
 	//Create a temporal entity to store the object
 	MyEntity* pTemp = new MyEntity(a_sFileName, a_sUniqueID);
 	//if I was able to generate it add it to the list
 	if (pTemp->IsInitialized())
 	{
-		//create a new temp array with one extra entry
-		PEntity* tempArray = new PEntity[m_uEntityCount + 1];
-		//start from 0 to the current count
-		uint uCount = 0;
-		for (uint i = 0; i < m_uEntityCount; ++i)
-		{
-			tempArray[uCount] = m_mEntityArray[i];
-			++uCount;
-		}
-		tempArray[uCount] = pTemp;
-		//if there was an older array delete
-		if (m_mEntityArray)
-		{
-			delete[] m_mEntityArray;
-		}
-		//make the member pointer the temp pointer
-		m_mEntityArray = tempArray;
-		//add one entity to the count
-		++m_uEntityCount;
+		SyncComponents(InsertEntity(pTemp));
+	}
+	else
+	{
+		SafeDelete(pTemp);
 	}
 }
+Simplex::uint Simplex::MyEntityManager::InsertEntity(MyEntity* a_pEntity)
+{
+	//grow geometrically so adding n entities does not reallocate n times
+	if (m_uEntityCount == m_uCapacity)
+		Reserve(m_uCapacity == 0 ? 16 : m_uCapacity * 2);
+
+	uint uIndex = m_uEntityCount;
+	m_mEntityArray[uIndex] = a_pEntity;
+
+	//the solver moves into the solver array
+	m_pSolverArray[uIndex] = *a_pEntity->GetSolver();
+	a_pEntity->SetSolver(&m_pSolverArray[uIndex]);
+	m_bPhysicsArray[uIndex] = false;
+	m_uIslandIDArray[uIndex] = 0;
+	m_bAwakeArray[uIndex] = false;
+
+	//issue a handle slot, reuse a released one if we have any
+	uint uSlot = m_uFreeSlot;
+	if (uSlot != -1)
+	{
+		m_uFreeSlot = m_uSlotArray[uSlot];
+	}
+	else
+	{
+		uSlot = m_uSlotCount;
+		m_uGenerationArray[uSlot] = 0;
+		++m_uSlotCount;
+	}
+	m_uSlotArray[uSlot] = uIndex;
+	m_uDenseSlotArray[uIndex] = uSlot;
+	m_IDHandleMap[a_pEntity->GetUniqueID()] = MyEntityHandle(uSlot, m_uGenerationArray[uSlot]);
+
+	//add one entity to the count
+	++m_uEntityCount;
+	return uIndex;
+}
+Simplex::uint Simplex::MyEntityManager::LoadScene(MyScene& a_Scene)
+{
+	uint uFirst = m_uEntityCount;
+	uint uSceneCount = a_Scene.GetEntityCount();
+
+	//allocate for the whole scene once instead of growing as the entities come
+	Reserve(m_uEntityCount + uSceneCount);
+	m_IDHandleMap.reserve(m_uEntityCount + uSceneCount);
+
+	//each model is loaded and scanned once, the entities only index this list
+	uint uPrototypeCount = a_Scene.GetPrototypeCount();
+	std::vector<MyEntity::MyPrototype*> prototypeList(uPrototypeCount);
+	for (uint i = 0; i < uPrototypeCount; ++i)
+		prototypeList[i] = MyEntity::GetPrototype(a_Scene.GetPrototype(i));
+
+	for (uint i = 0; i < uSceneCount; ++i)
+	{
+		MySceneEntity const& sceneEntity = a_Scene.GetEntity(i);
+		MyEntity::MyPrototype* pPrototype = nullptr;
+		if (sceneEntity.m_uPrototype < uPrototypeCount)
+			pPrototype = prototypeList[sceneEntity.m_uPrototype];
+		//the model could not be loaded
+		if (pPrototype == nullptr)
+			continue;
+
+		String sUniqueID = sceneEntity.m_sUniqueID;
+		GenUniqueID(sUniqueID);
+		MyEntity* pEntity = new MyEntity(pPrototype, sUniqueID);
+		uint uIndex = InsertEntity(pEntity);
+
+		//the parts go straight into the transform, no matrix to decompose
+		MyTransform* pTransform = pEntity->GetTransform();
+		pTransform->SetPosition(sceneEntity.m_v3Position);
+		pTransform->SetRotation(sceneEntity.m_qRotation);
+		pTransform->SetScale(sceneEntity.m_v3Scale);
+		pEntity->ApplyTransform();
+
+		MySolver& solver = m_pSolverArray[uIndex];
+		solver.SetPosition(sceneEntity.m_v3Position);
+		solver.SetSize(sceneEntity.m_v3Scale);
+		solver.SetMass(sceneEntity.m_fMass);
+		m_bPhysicsArray[uIndex] = sceneEntity.m_bPhysics;
+		if (sceneEntity.m_bPhysics)
+			solver.Wake();
+		pEntity->UsePhysicsSolver(sceneEntity.m_bPhysics);
+	}
+
+	//the bounds the broadphase reads are filled in one pass now that every entity is placed
+	for (uint i = uFirst; i < m_uEntityCount; ++i)
+		SyncComponents(i);
+
+	return m_uEntityCount - uFirst;
+}
 void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 {
 	//if the list is empty return
@@ -226,33 +1114,66 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
-	// if the entity is not the very last we swap it for the last one
-	if (a_uIndex != m_uEntityCount - 1)
-	{
-		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[m_uEntityCount - 1]);
-	}
-	
-	//and then pop the last one
-	//create a new temp array with one less entry
-	PEntity* tempArray = new PEntity[m_uEntityCount - 1];
-	//start from 0 to the current count
-	for (uint i = 0; i < m_uEntityCount - 1; ++i)
+	uint uLast = m_uEntityCount - 1;
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+
+	//sleeping entities do not refresh their colliding lists, they cannot keep pointing to this one
+	ClearCollisions(a_uIndex);
+
+	//whatever was resting on or against this entity lost its support, wake it up with its island
+	uint uSlot = m_uDenseSlotArray[a_uIndex];
+	//its parked contacts come back with the island, the loop below wakes the islands on their other end
+	if (IsSleeping(a_uIndex))
+		WakeIsland(a_uIndex);
+	for (auto contact = m_ContactMap.begin(); contact != m_ContactMap.end();)
 	{
-		tempArray[i] = m_mEntityArray[i];
+		MyContact& current = contact->second;
+		if (current.m_hEntityA.m_uSlot != uSlot && current.m_hEntityB.m_uSlot != uSlot)
+		{
+			++contact;
+			continue;
+		}
+		int nOther = GetEntityIndex(current.m_hEntityA.m_uSlot == uSlot ? current.m_hEntityB : current.m_hEntityA);
+		if (nOther >= 0 && IsSleeping(nOther))
+			WakeIsland(nOther);
+		//the list of this frame points into the map, it cannot keep the contact
+		m_ContactList.erase(std::remove(m_ContactList.begin(), m_ContactList.end(), &current), m_ContactList.end());
+		contact = m_ContactMap.erase(contact);
 	}
-	//if there was an older array delete
-	if (m_mEntityArray)
+
+	//release the handle slot, bumping the generation makes the outstanding handles stale
+	++m_uGenerationArray[uSlot];
+	m_uSlotArray[uSlot] = m_uFreeSlot;
+	m_uFreeSlot = uSlot;
+	m_IDHandleMap.erase(pEntity->GetUniqueID());
+
+	// if the entity is not the very last we move the last one into its place
+	if (a_uIndex != uLast)
 	{
-		delete[] m_mEntityArray;
+		m_mEntityArray[a_uIndex] = m_mEntityArray[uLast];
+		m_m4ToWorldArray[a_uIndex] = m_m4ToWorldArray[uLast];
+		m_v3MinGArray[a_uIndex] = m_v3MinGArray[uLast];
+		m_v3MaxGArray[a_uIndex] = m_v3MaxGArray[uLast];
+		m_pSolverArray[a_uIndex] = m_pSolverArray[uLast];
+		m_bPhysicsArray[a_uIndex] = m_bPhysicsArray[uLast];
+		m_uIslandIDArray[a_uIndex] = m_uIslandIDArray[uLast];
+		m_bAwakeArray[a_uIndex] = m_bAwakeArray[uLast];
+		m_mEntityArray[a_uIndex]->SetSolver(&m_pSolverArray[a_uIndex]);
+
+		m_uDenseSlotArray[a_uIndex] = m_uDenseSlotArray[uLast];
+		m_uSlotArray[m_uDenseSlotArray[a_uIndex]] = a_uIndex;
 	}
-	//make the member pointer the temp pointer
-	m_mEntityArray = tempArray;
-	//add one entity to the count
+	
+	//and then pop the last one
 	--m_uEntityCount;
+	SafeDelete(pEntity);
 }
 void Simplex::MyEntityManager::RemoveEntity(String a_sUniqueID)
 {
 	int nIndex = GetEntityIndex(a_sUniqueID);
+	//if not found there is nothing to remove (-1 would remove the last one)
+	if (nIndex < 0)
+		return;
 	RemoveEntity((uint)nIndex);
 }
 Simplex::String Simplex::MyEntityManager::GetUniqueID(uint a_uIndex)
@@ -279,6 +1200,15 @@ Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(uint a_uIndex)
 
 	return m_mEntityArray[a_uIndex];
 }
+Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(MyEntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the handle is stale return
+	if (nIndex < 0)
+		return nullptr;
+
+	return m_mEntityArray[nIndex];
+}
 void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigidBody)
 {
 	//if out of bounds will do it for all
@@ -298,7 +1228,7 @@ void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigi
 void Simplex::MyEntityManager::AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -320,7 +1250,7 @@ void Simplex::MyEntityManager::AddDimension(uint a_uIndex, uint a_uDimension)
 void Simplex::MyEntityManager::AddDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -342,7 +1272,7 @@ void Simplex::MyEntityManager::RemoveDimension(uint a_uIndex, uint a_uDimension)
 void Simplex::MyEntityManager::RemoveDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -371,7 +1301,7 @@ void Simplex::MyEntityManager::ClearDimensionSet(uint a_uIndex)
 void Simplex::MyEntityManager::ClearDimensionSet(String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -393,7 +1323,7 @@ bool Simplex::MyEntityManager::IsInDimension(uint a_uIndex, uint a_uDimension)
 bool Simplex::MyEntityManager::IsInDimension(String a_sUniqueID, uint a_uDimension)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -416,7 +1346,7 @@ bool Simplex::MyEntityManager::SharesDimension(uint a_uIndex, MyEntity* const a_
 bool Simplex::MyEntityManager::SharesDimension(String a_sUniqueID, MyEntity* const a_pOther)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity exists
 	if (pTemp)
 	{
@@ -424,13 +1354,20 @@ bool Simplex::MyEntityManager::SharesDimension(String a_sUniqueID, MyEntity* con
 	}
 	return false;
 }
+void Simplex::MyEntityManager::ApplyForce(vector3 a_v3Force, MyEntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity does not exists return
+	if (nIndex >= 0)
+		AddInput(nIndex, INPUT_FORCE, a_v3Force);
+	return;
+}
 void Simplex::MyEntityManager::ApplyForce(vector3 a_v3Force, String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity does not exists return
-	if(pTemp)
-		pTemp->ApplyForce(a_v3Force);
+	if (nIndex >= 0)
+		AddInput(nIndex, INPUT_FORCE, a_v3Force);
 	return;
 }
 void Simplex::MyEntityManager::ApplyForce(vector3 a_v3Force, uint a_uIndex)
@@ -443,17 +1380,22 @@ void Simplex::MyEntityManager::ApplyForce(vector3 a_v3Force, uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
-	return m_mEntityArray[a_uIndex]->ApplyForce(a_v3Force);
+	AddInput(a_uIndex, INPUT_FORCE, a_v3Force);
+}
+void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, MyEntityHandle a_hEntity)
+{
+	int nIndex = GetEntityIndex(a_hEntity);
+	//if the entity does not exists return
+	if (nIndex >= 0)
+		AddInput(nIndex, INPUT_POSITION, a_v3Position);
+	return;
 }
 void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity does not exists return
-	if (pTemp)
-	{
-		pTemp->SetPosition(a_v3Position);
-	}
+	if (nIndex >= 0)
+		AddInput(nIndex, INPUT_POSITION, a_v3Position);
 	return;
 }
 void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, uint a_uIndex)
@@ -466,14 +1408,14 @@ void Simplex::MyEntityManager::SetPosition(vector3 a_v3Position, uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
-	m_mEntityArray[a_uIndex]->SetPosition(a_v3Position);
+	AddInput(a_uIndex, INPUT_POSITION, a_v3Position);
 
 	return;
 }
 void Simplex::MyEntityManager::SetMass(float a_fMass, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	MyEntity* pTemp = GetEntity(GetEntityHandle(a_sUniqueID));
 	//if the entity does not exists return
 	if (pTemp)
 	{
@@ -498,11 +1440,11 @@ void Simplex::MyEntityManager::SetMass(float a_fMass, uint a_uIndex)
 void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, String a_sUniqueID)
 {
 	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	int nIndex = GetEntityIndex(a_sUniqueID);
 
 	//if the entity does not exists return
-	if (pTemp)
-		pTemp->UsePhysicsSolver(a_bUse);
+	if (nIndex >= 0)
+		UsePhysicsSolver(a_bUse, (uint)nIndex);
 	return;
 }
 void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, uint a_uIndex)
@@ -515,5 +1457,285 @@ void Simplex::MyEntityManager::UsePhysicsSolver(bool a_bUse, uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//the manager integrates from its own flag array, keep both in step
+	m_bPhysicsArray[a_uIndex] = a_bUse;
+	if (a_bUse)
+		m_pSolverArray[a_uIndex].Wake();
 	return m_mEntityArray[a_uIndex]->UsePhysicsSolver(a_bUse);
-}
\ No newline at end of file
+}
+void Simplex::MyEntityManager::AddInput(uint a_uIndex, eINPUT a_eType, vector3 a_v3Value)
+{
+	//while replaying the log is the only input, so the frames come out as they were recorded
+	if (m_bReplaying)
+		return;
+
+	MyInput input;
+	input.m_uFrame = m_uFrame + 1;
+	input.m_hEntity = GetEntityHandle(a_uIndex);
+	input.m_eType = a_eType;
+	input.m_v3Value = a_v3Value;
+	if (m_bRecording)
+		m_InputLog.push_back(input);
+	ApplyInput(input);
+}
+void Simplex::MyEntityManager::ApplyInput(MyInput const& a_Input)
+{
+	int nIndex = GetEntityIndex(a_Input.m_hEntity);
+	//if the entity does not exists return
+	if (nIndex < 0)
+		return;
+
+	switch (a_Input.m_eType)
+	{
+	case INPUT_FORCE:
+		m_mEntityArray[nIndex]->ApplyForce(a_Input.m_v3Value);
+		break;
+	case INPUT_POSITION:
+		m_mEntityArray[nIndex]->SetPosition(a_Input.m_v3Value);
+		break;
+	}
+}
+void Simplex::MyEntityManager::SetRecording(bool a_bRecording)
+{
+	if (a_bRecording)
+	{
+		m_InputLog.clear();
+		m_uReplayInput = 0;
+		m_uLogFrame = m_uFrame;
+	}
+	m_bRecording = a_bRecording;
+}
+bool Simplex::MyEntityManager::IsRecording(void) { return m_bRecording; }
+void Simplex::MyEntityManager::SetReplaying(bool a_bReplaying)
+{
+	m_bReplaying = a_bReplaying && m_uFrame < m_uLogFrame;
+	if (!m_bReplaying)
+		return;
+
+	//the inputs of the frames already simulated are skipped
+	m_uReplayInput = 0;
+	while (m_uReplayInput < m_InputLog.size() && m_InputLog[m_uReplayInput].m_uFrame <= m_uFrame)
+		++m_uReplayInput;
+}
+bool Simplex::MyEntityManager::IsReplaying(void) { return m_bReplaying; }
+void Simplex::MyEntityManager::SaveSnapshot(MySnapshot& a_Snapshot)
+{
+	a_Snapshot.Write(static_cast<uint>(SNAPSHOT_VERSION));
+	a_Snapshot.Write(m_uEntityCount);
+	a_Snapshot.Write(m_uFrame);
+	a_Snapshot.Write(m_uIslandCount);
+
+	//the colliding sets point at rigid bodies, they are written as entity indices
+	std::unordered_map<MyRigidBody*, uint> indexMap;
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		indexMap[m_mEntityArray[i]->GetRigidBody()] = i;
+	}
+
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		MyEntity* pEntity = m_mEntityArray[i];
+		a_Snapshot.WriteString(pEntity->GetUniqueID());
+		a_Snapshot.Write(m_bPhysicsArray[i]);
+		a_Snapshot.Write(m_uIslandIDArray[i]);
+		pEntity->GetTransform()->Save(a_Snapshot);
+		m_pSolverArray[i].Save(a_Snapshot);
+
+		MyRigidBody* pRigidBody = pEntity->GetRigidBody();
+		MyRigidBody::PRigidBody* pColliderArray = pRigidBody->GetColliderArray();
+		uint uColliderCount = pRigidBody->GetCollidingCount();
+		a_Snapshot.Write(uColliderCount);
+		for (uint j = 0; j < uColliderCount; j++)
+		{
+			a_Snapshot.Write(indexMap[pColliderArray[j]]);
+		}
+	}
+
+	//the order of the map does not matter, the solver walks the contacts in the order they are found
+	a_Snapshot.Write(static_cast<uint>(m_ContactMap.size()));
+	for (auto& contact : m_ContactMap)
+	{
+		a_Snapshot.Write(contact.first);
+		WriteContact(a_Snapshot, contact.second);
+	}
+	//the parked ones are listed in the islands again from the islands of their entities when read
+	a_Snapshot.Write(static_cast<uint>(m_SleepingContactMap.size()));
+	for (auto& contact : m_SleepingContactMap)
+	{
+		a_Snapshot.Write(contact.first);
+		WriteContact(a_Snapshot, contact.second);
+	}
+}
+bool Simplex::MyEntityManager::LoadSnapshot(MySnapshot& a_Snapshot)
+{
+	//read it dry first, a snapshot of another scene or a cut one leaves this one as it was
+	uint uOffset = a_Snapshot.GetOffset();
+	if (!ReadSnapshot(a_Snapshot, false))
+	{
+		a_Snapshot.Seek(uOffset);
+		return false;
+	}
+	a_Snapshot.Seek(uOffset);
+	return ReadSnapshot(a_Snapshot, true);
+}
+bool Simplex::MyEntityManager::ReadSnapshot(MySnapshot& a_Snapshot, bool a_bApply)
+{
+	uint uVersion = 0;
+	uint uEntityCount = 0;
+	uint uFrame = 0;
+	uint uIslandCount = 0;
+	if (!a_Snapshot.Read(uVersion) || uVersion != SNAPSHOT_VERSION ||
+		!a_Snapshot.Read(uEntityCount) || uEntityCount != m_uEntityCount ||
+		!a_Snapshot.Read(uFrame) || !a_Snapshot.Read(uIslandCount))
+		return false;
+
+	//the colliding sets and the island lists are built again from the ones saved
+	if (a_bApply)
+	{
+		m_IslandMap.clear();
+		for (uint i = 0; i < m_uEntityCount; i++)
+		{
+			m_mEntityArray[i]->GetRigidBody()->ClearCollidingList();
+		}
+	}
+
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		MyEntity* pEntity = m_mEntityArray[i];
+		String sUniqueID;
+		bool bPhysics = false;
+		uint uIslandID = 0;
+		if (!a_Snapshot.ReadString(sUniqueID) || sUniqueID != pEntity->GetUniqueID() ||
+			!a_Snapshot.Read(bPhysics) || !a_Snapshot.Read(uIslandID))
+			return false;
+
+		//a dry read goes into copies
+		MyTransform transform;
+		MySolver solver;
+		MyTransform* pTransform = a_bApply ? pEntity->GetTransform() : &transform;
+		MySolver* pSolver = a_bApply ? &m_pSolverArray[i] : &solver;
+		if (!pTransform->Load(a_Snapshot) || !pSolver->Load(a_Snapshot))
+			return false;
+
+		uint uColliderCount = 0;
+		if (!a_Snapshot.Read(uColliderCount))
+			return false;
+		for (uint j = 0; j < uColliderCount; j++)
+		{
+			uint uOther = 0;
+			if (!a_Snapshot.Read(uOther) || uOther >= m_uEntityCount)
+				return false;
+			if (a_bApply)
+				pEntity->GetRigidBody()->AddCollisionWith(m_mEntityArray[uOther]->GetRigidBody());
+		}
+
+		if (a_bApply)
+		{
+			m_bPhysicsArray[i] = bPhysics;
+			pEntity->UsePhysicsSolver(bPhysics);
+			m_uIslandIDArray[i] = uIslandID;
+			if (uIslandID != 0)
+			{
+				uint uSlot = m_uDenseSlotArray[i];
+				m_IslandMap[uIslandID].m_EntityList.push_back(MyEntityHandle(uSlot, m_uGenerationArray[uSlot]));
+			}
+			pEntity->ApplyTransform();
+			SyncComponents(i);
+		}
+	}
+
+	uint uContactCount = 0;
+	if (!a_Snapshot.Read(uContactCount))
+		return false;
+	if (a_bApply)
+	{
+		m_ContactMap.clear();
+		m_ContactList.clear();
+	}
+	for (uint i = 0; i < uContactCount; i++)
+	{
+		unsigned long long uKey = 0;
+		MyContact contact;
+		if (!a_Snapshot.Read(uKey) || !ReadContact(a_Snapshot, contact))
+			return false;
+		if (a_bApply)
+			m_ContactMap[uKey] = contact;
+	}
+
+	if (!a_Snapshot.Read(uContactCount))
+		return false;
+	if (a_bApply)
+		m_SleepingContactMap.clear();
+	for (uint i = 0; i < uContactCount; i++)
+	{
+		unsigned long long uKey = 0;
+		MyContact contact;
+		if (!a_Snapshot.Read(uKey) || !ReadContact(a_Snapshot, contact))
+			return false;
+		if (!a_bApply)
+			continue;
+		m_SleepingContactMap[uKey] = contact;
+		int nIndexA = GetEntityIndex(contact.m_hEntityA);
+		int nIndexB = GetEntityIndex(contact.m_hEntityB);
+		uint uIslandA = nIndexA >= 0 ? m_uIslandIDArray[nIndexA] : 0;
+		uint uIslandB = nIndexB >= 0 ? m_uIslandIDArray[nIndexB] : 0;
+		if (uIslandA != 0)
+			m_IslandMap[uIslandA].m_ContactKeyList.push_back(uKey);
+		if (uIslandB != 0 && uIslandB != uIslandA)
+			m_IslandMap[uIslandB].m_ContactKeyList.push_back(uKey);
+	}
+
+	if (a_bApply)
+	{
+		m_uFrame = uFrame;
+		m_uContactFrame = uFrame;
+		m_uIslandCount = uIslandCount;
+	}
+	return true;
+}
+void Simplex::MyEntityManager::SaveInputLog(MySnapshot& a_Snapshot)
+{
+	a_Snapshot.Write(static_cast<uint>(SNAPSHOT_VERSION));
+	a_Snapshot.Write(m_uLogFrame);
+	a_Snapshot.Write(static_cast<uint>(m_InputLog.size()));
+	for (uint i = 0; i < m_InputLog.size(); i++)
+	{
+		WriteInput(a_Snapshot, m_InputLog[i]);
+	}
+}
+bool Simplex::MyEntityManager::LoadInputLog(MySnapshot& a_Snapshot)
+{
+	uint uVersion = 0;
+	uint uLogFrame = 0;
+	uint uInputCount = 0;
+	if (!a_Snapshot.Read(uVersion) || uVersion != SNAPSHOT_VERSION ||
+		!a_Snapshot.Read(uLogFrame) || !a_Snapshot.Read(uInputCount) ||
+		//every input takes more than a byte, a count past the rest of the buffer is a broken log
+		uInputCount > a_Snapshot.GetSize() - a_Snapshot.GetOffset())
+		return false;
+
+	std::vector<MyInput> inputLog(uInputCount);
+	for (uint i = 0; i < uInputCount; i++)
+	{
+		if (!ReadInput(a_Snapshot, inputLog[i]))
+			return false;
+	}
+
+	m_InputLog.swap(inputLog);
+	m_uLogFrame = uLogFrame;
+	m_uReplayInput = 0;
+	m_bReplaying = false;
+	return true;
+}
+bool Simplex::MyEntityManager::Rewind(MySnapshot& a_Snapshot, uint a_uFrame)
+{
+	if (!LoadSnapshot(a_Snapshot))
+		return false;
+
+	SetReplaying(true);
+	while (m_uFrame < a_uFrame)
+	{
+		Update();
+	}
+	return true;
+}
@@ -6,16 +6,136 @@ Date: 2017/07
 #define __MYENTITYMANAGER_H_
 
 #include "MyEntity.h"
+#include "MyScene.h"
+
+#include <unordered_map>
+#include <algorithm>
 
 namespace Simplex
 {
 
+/*
+Reference to an entity that survives the reordering of the entity list (swap with last on removal),
+a handle whose generation does not match its slot anymore points to an entity that was removed
+*/
+struct MyEntityHandle
+{
+	uint m_uSlot; //slot in the handle table
+	uint m_uGeneration; //generation of the slot at the moment the handle was issued
+	MyEntityHandle() :m_uSlot(-1), m_uGeneration(0) {};
+	MyEntityHandle(uint a_uSlot, uint a_uGeneration) :m_uSlot(a_uSlot), m_uGeneration(a_uGeneration) {};
+};
+
+//Passes of the contact solver over all the contacts each frame
+#define CONTACT_ITERATIONS 8
+//Penetration left alone so resting contacts do not jitter in and out of touching
+#define CONTACT_SLOP 0.01f
+//Fraction of the penetration (past the slop) pushed out each frame
+#define CONTACT_CORRECTION 0.2f
+//Coulomb friction coefficient between entities
+#define CONTACT_FRICTION 0.5f
+//Fraction of its smallest extent an entity has to move in a frame to be swept instead of stepped
+#define CCD_THRESHOLD 0.5f
+//Impacts a swept entity can go through in one frame, after that it only moves up to what it hits
+#define CCD_MAX_STEPS 4
+//Version written at the start of snapshots and input logs, the ones of another version are not read
+#define SNAPSHOT_VERSION 3
+
+/*
+Contact between two entities, kept from frame to frame so the solver starts from the impulses it
+found the frame before (warm starting), the boxes do not rotate so one point is the whole manifold
+*/
+struct MyContact
+{
+	MyEntityHandle m_hEntityA; //entity with the lowest slot
+	MyEntityHandle m_hEntityB; //entity with the highest slot
+	uint m_uIndexA = 0; //index of A in the dense arrays this frame
+	uint m_uIndexB = 0; //index of B in the dense arrays this frame
+	float m_fInverseMassA = 0.0f; //inverse mass of A, 0 if it is not driven by its solver
+	float m_fInverseMassB = 0.0f; //inverse mass of B, 0 if it is not driven by its solver
+	vector3 m_v3Normal = AXIS_Y; //unit normal pointing from A to B
+	float m_fPenetration = 0.0f; //depth of the overlap along the normal
+	float m_fNormalImpulse = 0.0f; //impulse accumulated along the normal
+	float m_fPushImpulse = 0.0f; //push accumulated along the normal this frame, not warm started
+	vector3 m_v3TangentImpulse = ZERO_V3; //friction impulse accumulated on the contact plane
+	uint m_uFrame = 0; //last frame the entities were touching
+};
+
+//Entities of an island that fell asleep and the contacts they were resting on, the contacts are kept out of
+//the per frame walk until the island wakes up
+struct MyIsland
+{
+	std::vector<MyEntityHandle> m_EntityList; //entities put to sleep with the island
+	std::vector<unsigned long long> m_ContactKeyList; //keys of its contacts in the sleeping contact map
+};
+
+//Kinds of input the manager records
+enum eINPUT
+{
+	INPUT_FORCE, //ApplyForce
+	INPUT_POSITION //SetPosition
+};
+/*
+Input given to an entity from outside of the simulation, recorded with the frame it goes into so the
+frames after a snapshot can be simulated again exactly
+*/
+struct MyInput
+{
+	uint m_uFrame = 0; //frame the input is applied on
+	MyEntityHandle m_hEntity; //entity that got the input
+	eINPUT m_eType = INPUT_FORCE; //what the input does
+	vector3 m_v3Value = ZERO_V3; //force or position
+};
+
 //System Class
 class MyEntityManager
 {
 	typedef MyEntity* PEntity; //MyEntity Pointer
 	uint m_uEntityCount = 0; //number of elements in the list
+	uint m_uCapacity = 0; //number of elements the arrays can hold before growing
 	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
+
+	//Component arrays, dense and indexed the same as m_mEntityArray so whole scene passes walk contiguous memory
+	matrix4* m_m4ToWorldArray = nullptr; //model matrix of each entity
+	vector3* m_v3MinGArray = nullptr; //global minimum of the ARBB of each entity
+	vector3* m_v3MaxGArray = nullptr; //global maximum of the ARBB of each entity
+	MySolver* m_pSolverArray = nullptr; //solver of each entity, stored by value
+	bool* m_bPhysicsArray = nullptr; //is the entity driven by its solver?
+	uint* m_uIslandIDArray = nullptr; //island the entity fell asleep with, 0 while awake
+
+	//Awake list, rebuilt every frame so the broadphase and the integration only walk what moves
+	uint* m_uAwakeArray = nullptr; //indices of the entities awake this frame
+	uint m_uAwakeCount = 0; //number of entries in m_uAwakeArray
+	bool m_bVelocityDone = false; //were the velocities of this frame integrated? later wakes integrate their own
+	bool* m_bAwakeArray = nullptr; //is the entity in m_uAwakeArray?
+
+	//Islands, scratch for grouping the awake entities that touch each other
+	uint* m_uIslandArray = nullptr; //parent of the entity in its island, the root is its own parent
+	bool* m_bIslandRestArray = nullptr; //for the roots, can every entity of the island sleep?
+	uint m_uIslandCount = 0; //islands put to sleep so far, gives each one its ID
+	std::unordered_map<uint, MyIsland> m_IslandMap; //island ID -> entities and contacts sleeping in it
+
+	//Handle table
+	uint* m_uSlotArray = nullptr; //slot -> index in the dense arrays (or next free slot if the slot is free)
+	uint* m_uGenerationArray = nullptr; //generation of each slot, increased every time the slot is released
+	uint* m_uDenseSlotArray = nullptr; //index in the dense arrays -> slot
+	uint m_uSlotCount = 0; //number of slots ever issued
+	uint m_uFreeSlot = -1; //head of the list of free slots
+	std::unordered_map<String, MyEntityHandle> m_IDHandleMap; //unique ID -> handle, the only index of IDs
+
+	//Contacts
+	std::unordered_map<unsigned long long, MyContact> m_ContactMap; //slots of the pair -> persistent contact
+	std::vector<MyContact*> m_ContactList; //contacts touching this frame, the ones the solver walks
+	std::unordered_map<unsigned long long, MyContact> m_SleepingContactMap; //contacts between sleeping entities
+	uint m_uContactFrame = 0; //last frame the contacts were pruned, sleeping contacts go back as touching then
+	uint m_uFrame = 0; //frames updated, tells the contacts that are still touching apart
+
+	std::vector<MyInput> m_InputLog; //inputs recorded since the recording started, in frame order
+	bool m_bRecording = false; //are the inputs being added to the log?
+	bool m_bReplaying = false; //are the inputs coming from the log instead of from outside?
+	uint m_uReplayInput = 0; //next input of the log to replay
+	uint m_uLogFrame = 0; //last frame the log covers
+
 	static MyEntityManager* m_pInstance; // Singleton pointer
 public:
 	/*
@@ -37,6 +157,37 @@ public:
 	*/
 	int GetEntityIndex(String a_sUniqueID);
 	/*
+	USAGE: Gets the index (from the list of entities) of the entity referenced by the handle
+	ARGUMENTS: MyEntityHandle a_hEntity -> handle of the entity
+	OUTPUT: index from the list of entities, -1 if the handle is stale or invalid
+	*/
+	int GetEntityIndex(MyEntityHandle a_hEntity);
+	/*
+	USAGE: Gets a handle to the entity, the handle stays valid when other entities get removed
+	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
+	OUTPUT: handle of the entity, invalid handle if the list is empty
+	*/
+	MyEntityHandle GetEntityHandle(uint a_uIndex = -1);
+	/*
+	USAGE: Gets a handle to the entity specified by unique ID
+	ARGUMENTS: String a_sUniqueID -> Unique Identifier
+	OUTPUT: handle of the entity, invalid handle if not found
+	*/
+	MyEntityHandle GetEntityHandle(String a_sUniqueID);
+	/*
+	USAGE: Asks if the handle still references an entity in the list
+	ARGUMENTS: MyEntityHandle a_hEntity -> handle of the entity
+	OUTPUT: is the handle valid?
+	*/
+	bool IsValidHandle(MyEntityHandle a_hEntity);
+	/*
+	USAGE: Allocates the arrays for the specified number of entities, so adding entities up to that
+	count will not reallocate, it will never shrink the arrays
+	ARGUMENTS: uint a_uCapacity -> number of entities to allocate for
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCapacity);
+	/*
 	USAGE: Will add an entity to the list
 	ARGUMENTS:
 	-	String a_sFileName -> Name of the model to load
@@ -45,6 +196,13 @@ public:
 	*/
 	void AddEntity(String a_sFileName, String a_sUniqueID = "NA");
 	/*
+	USAGE: Adds all the entities of a scene at once, the arrays grow once, each model is loaded once
+		and the bounds are filled in a single pass after every entity is placed
+	ARGUMENTS: MyScene& a_Scene -> scene to add, entities whose model can not be loaded are skipped
+	OUTPUT: number of entities added
+	*/
+	uint LoadScene(MyScene& a_Scene);
+	/*
 	USAGE: Deletes the MyEntity Specified by unique ID and removes it from the list
 	ARGUMENTS: uint a_uIndex -> index of the queried entry, if < 0 asks for the last one added
 	OUTPUT: ---
@@ -69,6 +227,12 @@ public:
 	*/
 	MyEntity* GetEntity(uint a_uIndex = -1);
 	/*
+	USAGE: Gets the entity referenced by the handle
+	ARGUMENTS: MyEntityHandle a_hEntity -> handle of the entity
+	OUTPUT: MyEntity referenced, nullptr if the handle is stale or invalid
+	*/
+	MyEntity* GetEntity(MyEntityHandle a_hEntity);
+	/*
 	USAGE: Will update the MyEntity manager
 	ARGUMENTS: ---
 	OUTPUT: ---
@@ -111,6 +275,12 @@ public:
 	*/
 	matrix4 GetModelMatrix(String a_sUniqueID);
 	/*
+	USAGE: Gets the model matrix associated with this entity
+	ARGUMENTS: MyEntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: model to world matrix
+	*/
+	matrix4 GetModelMatrix(MyEntityHandle a_hEntity);
+	/*
 	USAGE: Sets the model matrix associated to the entity specified in the ID
 	ARGUMENTS:
 	-	matrix4 a_m4ToWorld -> model matrix to set
@@ -127,6 +297,14 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID);
 	/*
+	USAGE: Sets the model matrix associated to the entity referenced by the handle
+	ARGUMENTS:
+	-	matrix4 a_m4ToWorld -> model matrix to set
+	-	MyEntityHandle a_hEntity -> handle of the queried entity
+	OUTPUT: ---
+	*/
+	void SetModelMatrix(matrix4 a_m4ToWorld, MyEntityHandle a_hEntity);
+	/*
 	USAGE: Sets the axis visibility associated to the entity specified in the ID
 	ARGUMENTS: 
 	-	bool a_bVisibility -> visibility of the axis
@@ -246,6 +424,85 @@ public:
 	OUTPUT: MyEntity count
 	*/
 	uint GetEntityCount(void);
+	/*
+	USAGE: Will return the count of entities driven by their solver that were awake the last update
+	ARGUMENTS: ---
+	OUTPUT: awake count
+	*/
+	uint GetAwakeCount(void);
+	/*
+	USAGE: Will return the count of contacts solved the last update
+	ARGUMENTS: ---
+	OUTPUT: contact count
+	*/
+	uint GetContactCount(void);
+	/*
+	USAGE: Will return the number of frames updated
+	ARGUMENTS: ---
+	OUTPUT: frame count
+	*/
+	uint GetFrame(void);
+	/*
+	USAGE: Writes the state of the simulation to the snapshot: the frame, the transform, solver and
+		colliding set of each entity and the contacts the solver warm starts from
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to append to
+	OUTPUT: ---
+	*/
+	void SaveSnapshot(MySnapshot& a_Snapshot);
+	/*
+	USAGE: Reads a state written by SaveSnapshot from the reading position of the snapshot, the entities
+		have to be the same and in the same order as when it was saved
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to read from
+	OUTPUT: was the state restored? nothing is changed if it was not
+	*/
+	bool LoadSnapshot(MySnapshot& a_Snapshot);
+	/*
+	USAGE: Starts or stops adding the forces and positions given to the entities to the input log,
+		starting empties the log so take a snapshot at the same time
+	ARGUMENTS: bool a_bRecording -> record?
+	OUTPUT: ---
+	*/
+	void SetRecording(bool a_bRecording);
+	/*
+	USAGE: Asks if the inputs are being recorded
+	ARGUMENTS: ---
+	OUTPUT: recording?
+	*/
+	bool IsRecording(void);
+	/*
+	USAGE: Starts or stops feeding the inputs of the log to the frames after the current one, the inputs
+		from outside are ignored while it lasts and it stops by itself at the end of the log
+	ARGUMENTS: bool a_bReplaying -> replay?
+	OUTPUT: ---
+	*/
+	void SetReplaying(bool a_bReplaying);
+	/*
+	USAGE: Asks if the inputs are coming from the log
+	ARGUMENTS: ---
+	OUTPUT: replaying?
+	*/
+	bool IsReplaying(void);
+	/*
+	USAGE: Writes the input log to the snapshot
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to append to
+	OUTPUT: ---
+	*/
+	void SaveInputLog(MySnapshot& a_Snapshot);
+	/*
+	USAGE: Replaces the input log with one written by SaveInputLog
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to read from
+	OUTPUT: was the log read? the log is left as it was if it was not
+	*/
+	bool LoadInputLog(MySnapshot& a_Snapshot);
+	/*
+	USAGE: Restores a snapshot and simulates again with the input log up to a frame, to look at that
+		frame again (profiling, debugging) or to compare the results of two builds
+	ARGUMENTS:
+	-	MySnapshot& a_Snapshot -> snapshot to restore, read from its reading position
+	-	uint a_uFrame -> frame to stop at
+	OUTPUT: was the snapshot restored?
+	*/
+	bool Rewind(MySnapshot& a_Snapshot, uint a_uFrame);
 
 	/*
 	USAGE: applies a force to the specified object
@@ -264,6 +521,14 @@ public:
 	*/
 	void ApplyForce(vector3 a_v3Force, uint a_uIndex = -1);
 	/*
+	USAGE: applies a force to the entity referenced by the handle
+	ARGUMENTS:
+	-	vector3 a_v3Force -> force to apply
+	-	MyEntityHandle a_hEntity -> handle of the MyEntity
+	OUTPUT: ---
+	*/
+	void ApplyForce(vector3 a_v3Force, MyEntityHandle a_hEntity);
+	/*
 	USAGE: Sets the position of the specified entity
 	ARGUMENTS:
 	-	vector3 a_v3Position -> position to set
@@ -280,6 +545,14 @@ public:
 	*/
 	void SetPosition(vector3 a_v3Position, uint a_uIndex = -1);
 	/*
+	USAGE: Sets the position of the entity referenced by the handle
+	ARGUMENTS:
+	-	vector3 a_v3Position -> position to set
+	-	MyEntityHandle a_hEntity -> handle of the MyEntity
+	OUTPUT: ---
+	*/
+	void SetPosition(vector3 a_v3Position, MyEntityHandle a_hEntity);
+	/*
 	USAGE: Sets the mass of the specified entity
 	ARGUMENTS:
 	-	float a_fMass -> mass to set
@@ -348,6 +621,150 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: Points every entity to its solver in the solver array, needed every time the array moves
+	Arguments: ---
+	Output: ---
+	*/
+	void LinkSolvers(void);
+	/*
+	Usage: Will generate a unique id based on the name provided
+	Arguments: String& a_sUniqueID -> desired name
+	Output: will output though the argument
+	*/
+	void GenUniqueID(String& a_sUniqueID);
+	/*
+	Usage: Copies the model matrix and the global ARBB of the entity into the dense arrays
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void SyncComponents(uint a_uIndex);
+	/*
+	Usage: Asks if the entity is driven by its solver and the solver is awake
+	Arguments: uint a_uIndex -> index of the entity
+	Output: is it moving?
+	*/
+	bool IsAwake(uint a_uIndex);
+	/*
+	Usage: Asks if the entity is driven by its solver and the solver is asleep
+	Arguments: uint a_uIndex -> index of the entity
+	Output: is it sleeping?
+	*/
+	bool IsSleeping(uint a_uIndex);
+	/*
+	Usage: Empties the colliding list of the entity and takes it out of the lists of the entities it
+		was colliding with, so the ones sleeping do not keep a stale entry
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void ClearCollisions(uint a_uIndex);
+	/*
+	Usage: Finds or creates the contact of two colliding entities and refreshes its normal and
+		penetration, waking up the entity that is asleep if the other one is moving
+	Arguments:
+	-	uint a_uIndexA -> index of the first entity
+	-	uint a_uIndexB -> index of the second entity
+	Output: ---
+	*/
+	void UpdateContact(uint a_uIndexA, uint a_uIndexB);
+	/*
+	Usage: Sequential impulses over the contacts of this frame, warm started with the impulses of the
+		last one, the penetration is pushed out with split impulses that do not add momentum
+	Arguments: ---
+	Output: ---
+	*/
+	void SolveContacts(void);
+	/*
+	Usage: Asks if the entity moves far enough this frame to go through something if it was stepped
+	Arguments: uint a_uIndex -> index of the entity
+	Output: does it need to be swept?
+	*/
+	bool IsFast(uint a_uIndex);
+	/*
+	Usage: Moves a fast entity in substeps, each one up to the first box its swept box hits, the impact
+		takes the velocity into the face (sharing it with the entity hit) and the entity slides along
+		the face for the rest of the frame, past CCD_MAX_STEPS impacts what is left of the frame is
+		moved up to the first box hit without solving the impact
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void SweepEntity(uint a_uIndex);
+	/*
+	Usage: Finds the first box the swept box of the entity hits, the others are taken as still
+	Arguments:
+	-	uint a_uIndex -> index of the entity
+	-	vector3 a_v3Motion -> motion of the entity
+	-	float& a_fTime -> fraction of the motion before the impact, 1 if there is none
+	-	vector3& a_v3Normal -> normal of the face hit
+	Output: index of the entity hit, -1 if there is none
+	*/
+	int FindSweepHit(uint a_uIndex, vector3 a_v3Motion, float& a_fTime, vector3& a_v3Normal);
+	/*
+	Usage: Wakes the entity up and, if it was sleeping with an island, all the entities of the island,
+		adding them to the awake list; past the velocity integration of the frame their velocity is
+		integrated as they wake up so every entity moving this frame got its forces
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void WakeIsland(uint a_uIndex);
+	/*
+	Usage: Wakes a single entity up and adds it to the awake list
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void WakeEntity(uint a_uIndex);
+	/*
+	Usage: Finds the root of the island of the entity, halving the path on the way
+	Arguments: uint a_uIndex -> index of the entity
+	Output: index of the root
+	*/
+	uint FindIsland(uint a_uIndex);
+	/*
+	Usage: Groups the awake entities touching each other into islands and puts to sleep the islands
+		where every entity can sleep, so a stack sleeps and wakes up as one
+	Arguments: ---
+	Output: ---
+	*/
+	void UpdateIslands(void);
+	/*
+	Usage: Drops the contacts that stopped touching and moves the ones between two sleeping entities to
+		the sleeping contact map, listed in the islands of both, so they can warm start when the entities
+		wake up without being walked every frame
+	Arguments: ---
+	Output: ---
+	*/
+	void PruneContacts(void);
+	/*
+	Usage: Applies an input from outside, adding it to the log if recording, inputs from outside are
+		ignored while replaying
+	Arguments:
+	-	uint a_uIndex -> index of the entity
+	-	eINPUT a_eType -> what the input does
+	-	vector3 a_v3Value -> force or position
+	Output: ---
+	*/
+	void AddInput(uint a_uIndex, eINPUT a_eType, vector3 a_v3Value);
+	/*
+	Usage: Applies an input to the entity it was given to, if it still exists
+	Arguments: MyInput const& a_Input -> input to apply
+	Output: ---
+	*/
+	void ApplyInput(MyInput const& a_Input);
+	/*
+	Usage: Reads a snapshot written by SaveSnapshot
+	Arguments:
+	-	MySnapshot& a_Snapshot -> snapshot to read from
+	-	bool a_bApply -> restore the state? a dry read only checks the snapshot fits the entities
+	Output: could it be read?
+	*/
+	bool ReadSnapshot(MySnapshot& a_Snapshot, bool a_bApply);
+	/*
+	Usage: Adds an entity to the arrays and issues its handle, growing them if they are full; its bounds
+		are left for the caller to sync
+	Arguments: MyEntity* a_pEntity -> initialized entity, the manager takes ownership of it
+	Output: index of the entity in the list
+	*/
+	uint InsertEntity(MyEntity* a_pEntity);
 };//class
 
 } //namespace Simplex
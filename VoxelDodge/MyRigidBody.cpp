@@ -1,4 +1,5 @@
 #include "MyRigidBody.h"
+#include "Simplex\Physics\RigidBody.h" //eSATResults
 using namespace Simplex;
 //Allocation
 void MyRigidBody::Init(void)
@@ -95,44 +96,32 @@ void MyRigidBody::SetModelMatrix(matrix4 a_m4ModelMatrix)
 
 	m_v3CenterG = vector3(m_m4ToWorld * vector4(m_v3CenterL, 1.0f));
 
-	//Calculate the 8 corners of the cube
-	vector3 v3Corner[8];
-	//Back square
-	v3Corner[0] = m_v3MinL;
-	v3Corner[1] = vector3(m_v3MaxL.x, m_v3MinL.y, m_v3MinL.z);
-	v3Corner[2] = vector3(m_v3MinL.x, m_v3MaxL.y, m_v3MinL.z);
-	v3Corner[3] = vector3(m_v3MaxL.x, m_v3MaxL.y, m_v3MinL.z);
-
-	//Front square
-	v3Corner[4] = vector3(m_v3MinL.x, m_v3MinL.y, m_v3MaxL.z);
-	v3Corner[5] = vector3(m_v3MaxL.x, m_v3MinL.y, m_v3MaxL.z);
-	v3Corner[6] = vector3(m_v3MinL.x, m_v3MaxL.y, m_v3MaxL.z);
-	v3Corner[7] = m_v3MaxL;
-
-	//Place them in world space
-	for (uint uIndex = 0; uIndex < 8; ++uIndex)
-	{
-		v3Corner[uIndex] = vector3(m_m4ToWorld * vector4(v3Corner[uIndex], 1.0f));
-	}
-
-	//Identify the max and min as the first corner
-	m_v3MaxG = m_v3MinG = v3Corner[0];
+	//the global box comes from the half widths, not from transforming the 8 corners
+	MyTransform::GetARBB(m_m4ToWorld, m_v3CenterL, m_v3HalfWidth, m_v3MinG, m_v3MaxG);
 
-	//get the new max and min for the global box
-	for (uint i = 1; i < 8; ++i)
-	{
-		if (m_v3MaxG.x < v3Corner[i].x) m_v3MaxG.x = v3Corner[i].x;
-		else if (m_v3MinG.x > v3Corner[i].x) m_v3MinG.x = v3Corner[i].x;
+	//we calculate the distance between min and max vectors
+	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
+}
+void MyRigidBody::SetTransform(MyTransform& a_transform)
+{
+	uint uChange = a_transform.GetChange();
+	if (uChange == TRANSFORM_NONE)
+		return;
 
-		if (m_v3MaxG.y < v3Corner[i].y) m_v3MaxG.y = v3Corner[i].y;
-		else if (m_v3MinG.y > v3Corner[i].y) m_v3MinG.y = v3Corner[i].y;
+	m_m4ToWorld = a_transform.GetMatrix();
+	m_v3CenterG = vector3(m_m4ToWorld * vector4(m_v3CenterL, 1.0f));
 
-		if (m_v3MaxG.z < v3Corner[i].z) m_v3MaxG.z = v3Corner[i].z;
-		else if (m_v3MinG.z > v3Corner[i].z) m_v3MinG.z = v3Corner[i].z;
+	//a translation keeps the size of the box, only rotation and scale change it
+	if (uChange == TRANSFORM_POSITION)
+	{
+		m_v3MinG = m_v3CenterG - m_v3ARBBSize * 0.5f;
+		m_v3MaxG = m_v3CenterG + m_v3ARBBSize * 0.5f;
+	}
+	else
+	{
+		a_transform.GetARBB(m_v3CenterL, m_v3HalfWidth, m_v3MinG, m_v3MaxG);
+		m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 	}
-
-	//we calculate the distance between min and max vectors
-	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 }
 //The big 3
 MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
@@ -164,6 +153,7 @@ MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 	//with model matrix being the identity, local and global are the same
 	m_v3MinG = m_v3MinL;
 	m_v3MaxG = m_v3MaxL;
+	m_v3ARBBSize = m_v3MaxG - m_v3MinG;
 
 	//with the max and the min we calculate the center
 	m_v3CenterL = (m_v3MaxL + m_v3MinL) / 2.0f;
@@ -257,7 +247,7 @@ void MyRigidBody::RemoveCollisionWith(MyRigidBody* other)
 			pTemp = new PRigidBody[m_uCollidingCount - 1];
 			if (m_CollidingArray)
 			{
-				memcpy(pTemp, m_CollidingArray, sizeof(uint) * (m_uCollidingCount - 1));
+				memcpy(pTemp, m_CollidingArray, sizeof(MyRigidBody*) * (m_uCollidingCount - 1));
 				delete[] m_CollidingArray;
 				m_CollidingArray = nullptr;
 			}
@@ -277,13 +267,93 @@ void MyRigidBody::ClearCollidingList(void)
 		m_CollidingArray = nullptr;
 	}
 }
-uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
+/*
+USAGE: Overlap of the projections of two oriented boxes on an axis
+ARGUMENTS:
+-	vector3 a_v3Axis -> unit axis to project on
+-	vector3 const* a_pAxisA -> unit axes of the first box
+-	vector3 a_v3HalfA -> half widths of the first box along its axes
+-	vector3 const* a_pAxisB -> unit axes of the second box
+-	vector3 a_v3HalfB -> half widths of the second box along its axes
+-	vector3 a_v3Distance -> vector from the center of the first box to the center of the second
+OUTPUT: overlap, negative if the axis separates the boxes
+*/
+static float ProjectedOverlap(vector3 a_v3Axis, vector3 const* a_pAxisA, vector3 a_v3HalfA,
+	vector3 const* a_pAxisB, vector3 a_v3HalfB, vector3 a_v3Distance)
+{
+	float fRadiusA = 0.0f;
+	float fRadiusB = 0.0f;
+	for (uint i = 0; i < 3; ++i)
+	{
+		fRadiusA += a_v3HalfA[i] * std::abs(glm::dot(a_pAxisA[i], a_v3Axis));
+		fRadiusB += a_v3HalfB[i] * std::abs(glm::dot(a_pAxisB[i], a_v3Axis));
+	}
+	return fRadiusA + fRadiusB - std::abs(glm::dot(a_v3Distance, a_v3Axis));
+}
+uint MyRigidBody::SAT(MyRigidBody* const a_pOther, vector3* a_pNormal, float* a_pPenetration)
 {
+	//axes of both boxes in global space, the scale of each axis goes into the half widths
+	vector3 v3AxisA[3];
+	vector3 v3AxisB[3];
+	vector3 v3HalfA = m_v3HalfWidth;
+	vector3 v3HalfB = a_pOther->m_v3HalfWidth;
+	for (uint i = 0; i < 3; ++i)
+	{
+		v3AxisA[i] = vector3(m_m4ToWorld[i]);
+		float fLength = glm::length(v3AxisA[i]);
+		v3HalfA[i] *= fLength;
+		if (fLength > 0.0f)
+			v3AxisA[i] /= fLength;
+
+		v3AxisB[i] = vector3(a_pOther->m_m4ToWorld[i]);
+		fLength = glm::length(v3AxisB[i]);
+		v3HalfB[i] *= fLength;
+		if (fLength > 0.0f)
+			v3AxisB[i] /= fLength;
+	}
+	vector3 v3Distance = a_pOther->m_v3CenterG - m_v3CenterG;
+
+	//the 15 candidates in the order of eSATResults, the axis of least overlap is the contact normal
+	float fMinOverlap = std::numeric_limits<float>::max();
+	vector3 v3MinAxis = AXIS_Y;
+	for (uint uTest = SAT_AX; uTest <= SAT_AZxBZ; ++uTest)
+	{
+		vector3 v3Axis;
+		if (uTest <= SAT_AZ)
+			v3Axis = v3AxisA[uTest - SAT_AX];
+		else if (uTest <= SAT_BZ)
+			v3Axis = v3AxisB[uTest - SAT_BX];
+		else
+		{
+			uint uEdge = uTest - SAT_AXxBX;
+			v3Axis = glm::cross(v3AxisA[uEdge / 3], v3AxisB[uEdge % 3]);
+			//parallel edges give no axis, the face axes already covered that direction
+			float fLength = glm::length(v3Axis);
+			if (fLength < 0.0001f)
+				continue;
+			v3Axis /= fLength;
+		}
+
+		float fOverlap = ProjectedOverlap(v3Axis, v3AxisA, v3HalfA, v3AxisB, v3HalfB, v3Distance);
+		if (fOverlap < 0.0f)
+			return uTest;
+		if (fOverlap < fMinOverlap)
+		{
+			fMinOverlap = fOverlap;
+			v3MinAxis = v3Axis;
+		}
+	}
+
 	// Since no separating axis found, the OBBs must be intersecting
-	/*
-	This is not complete as this is the solution of an assignment
-	*/
-	return 0;
+	if (a_pNormal)
+		*a_pNormal = glm::dot(v3MinAxis, v3Distance) < 0.0f ? -v3MinAxis : v3MinAxis;
+	if (a_pPenetration)
+		*a_pPenetration = fMinOverlap;
+	return SAT_NONE;
+}
+bool MyRigidBody::GetContact(MyRigidBody* const a_pOther, vector3& a_v3Normal, float& a_fPenetration)
+{
+	return SAT(a_pOther, &a_v3Normal, &a_fPenetration) == SAT_NONE;
 }
 bool MyRigidBody::IsColliding(MyRigidBody* const other)
 {
@@ -308,6 +378,10 @@ bool MyRigidBody::IsColliding(MyRigidBody* const other)
 		if (this->m_v3MinG.z > other->m_v3MaxG.z) //this in front of other
 			bColliding = false;
 
+		//the boxes can overlap and the oriented boxes inside them still be apart
+		if (bColliding)
+			bColliding = SAT(other) == SAT_NONE;
+
 		if (bColliding) //they are colliding with bounding box also
 		{
 			this->AddCollisionWith(other);
@@ -5,7 +5,7 @@ Date: 2017/06
 #ifndef __MYRIGIDBODY_H_
 #define __MYRIGIDBODY_H_
 
-#include "Simplex\Mesh\Model.h"
+#include "MyTransform.h"
 
 namespace Simplex
 {
@@ -111,6 +111,16 @@ public:
 	OUTPUT: are they colliding?
 	*/
 	bool IsColliding(MyRigidBody* const other);
+	/*
+	USAGE: Calculates the contact between the oriented bounding boxes of both rigid bodies, the
+		normal is the axis of least penetration
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body
+	-	vector3& a_v3Normal -> (output) unit normal of the contact pointing from this to the other
+	-	float& a_fPenetration -> (output) depth of the overlap along the normal
+	OUTPUT: are the boxes overlapping? the outputs are only written if they are
+	*/
+	bool GetContact(MyRigidBody* const a_pOther, vector3& a_v3Normal, float& a_fPenetration);
 #pragma region Accessors
 	/*
 	Usage: Gets visibility of bounding sphere
@@ -233,6 +243,13 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ModelMatrix);
 	/*
+	USAGE: Places the rigid body with a transform, only moving the ARBB when the transform
+		just changed its position
+	ARGUMENTS: MyTransform& a_transform -> transform to follow, its changes are not cleared
+	OUTPUT: ---
+	*/
+	void SetTransform(MyTransform& a_transform);
+	/*
 	USAGE: Gets the array of rigid bodies pointer this one is colliding with
 	ARGUMENTS: ---
 	OUTPUT: list of colliding rigid bodies
@@ -267,10 +284,13 @@ private:
 	void Init(void);
 	/*
 	USAGE: This will apply the Separation Axis Test
-	ARGUMENTS: MyRigidBody* const a_pOther -> other rigid body to test against
+	ARGUMENTS:
+	-	MyRigidBody* const a_pOther -> other rigid body to test against
+	-	vector3* a_pNormal = nullptr -> (output) axis of least overlap pointing to the other, if colliding
+	-	float* a_pPenetration = nullptr -> (output) overlap along that axis, if colliding
 	OUTPUT: 0 for colliding, all other first axis that succeeds test
 	*/
-	uint SAT(MyRigidBody* const a_pOther);
+	uint SAT(MyRigidBody* const a_pOther, vector3* a_pNormal = nullptr, float* a_pPenetration = nullptr);
 };//class
 
 } //namespace Simplex
@@ -0,0 +1,222 @@
+#include "MyScene.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+using namespace Simplex;
+//tells scene files from any other file
+static const uint SCENE_MAGIC = 0x454E4353; //"SCNE"
+//  MyScene
+void MyScene::Init(void)
+{
+	m_PrototypeList.clear();
+	m_EntityList.clear();
+}
+void MyScene::Swap(MyScene& other)
+{
+	std::swap(m_PrototypeList, other.m_PrototypeList);
+	std::swap(m_EntityList, other.m_EntityList);
+}
+void MyScene::Release(void){/*the vectors release themselves*/ }
+//The big 3
+MyScene::MyScene(void){ Init(); }
+MyScene::MyScene(MyScene const& other)
+{
+	m_PrototypeList = other.m_PrototypeList;
+	m_EntityList = other.m_EntityList;
+}
+MyScene& MyScene::operator=(MyScene const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyScene temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyScene::~MyScene() { Release(); }
+
+//Accessors
+uint MyScene::GetPrototypeCount(void) { return static_cast<uint>(m_PrototypeList.size()); }
+String MyScene::GetPrototype(uint a_uIndex)
+{
+	if (a_uIndex >= m_PrototypeList.size())
+		return "";
+	return m_PrototypeList[a_uIndex];
+}
+uint MyScene::GetEntityCount(void) { return static_cast<uint>(m_EntityList.size()); }
+MySceneEntity& MyScene::GetEntity(uint a_uIndex) { return m_EntityList[a_uIndex]; }
+
+//--- Methods
+uint MyScene::AddPrototype(String a_sFileName)
+{
+	//scenes use a handful of models, a linear search is enough
+	for (uint i = 0; i < m_PrototypeList.size(); ++i)
+	{
+		if (m_PrototypeList[i] == a_sFileName)
+			return i;
+	}
+	m_PrototypeList.push_back(a_sFileName);
+	return static_cast<uint>(m_PrototypeList.size() - 1);
+}
+void MyScene::AddEntity(MySceneEntity const& a_Entity) { m_EntityList.push_back(a_Entity); }
+void MyScene::Reserve(uint a_uCapacity) { m_EntityList.reserve(a_uCapacity); }
+void MyScene::Clear(void) { Init(); }
+bool MyScene::IsValid(void)
+{
+	uint uPrototypeCount = GetPrototypeCount();
+	for (uint i = 0; i < m_PrototypeList.size(); ++i)
+	{
+		if (m_PrototypeList[i].empty())
+			return false;
+	}
+	for (uint i = 0; i < m_EntityList.size(); ++i)
+	{
+		if (m_EntityList[i].m_uPrototype >= uPrototypeCount || m_EntityList[i].m_sUniqueID.empty())
+			return false;
+	}
+	return true;
+}
+bool MyScene::Save(String a_sFileName)
+{
+	MySnapshot snapshot;
+	snapshot.Write(SCENE_MAGIC);
+	snapshot.Write(static_cast<uint>(SCENE_VERSION));
+
+	snapshot.Write(GetPrototypeCount());
+	for (uint i = 0; i < m_PrototypeList.size(); ++i)
+		snapshot.WriteString(m_PrototypeList[i]);
+
+	snapshot.Write(GetEntityCount());
+	for (uint i = 0; i < m_EntityList.size(); ++i)
+	{
+		MySceneEntity const& entity = m_EntityList[i];
+		snapshot.WriteString(entity.m_sUniqueID);
+		snapshot.Write(entity.m_uPrototype);
+		snapshot.Write(entity.m_v3Position);
+		snapshot.Write(entity.m_qRotation);
+		snapshot.Write(entity.m_v3Scale);
+		snapshot.Write(entity.m_bPhysics);
+		snapshot.Write(entity.m_fMass);
+	}
+	return snapshot.SaveFile(a_sFileName);
+}
+bool MyScene::Load(String a_sFileName)
+{
+	MySnapshot snapshot;
+	if (!snapshot.LoadFile(a_sFileName))
+		return false;
+
+	uint uMagic = 0;
+	uint uVersion = 0;
+	if (!snapshot.Read(uMagic) || uMagic != SCENE_MAGIC)
+		return false;
+	if (!snapshot.Read(uVersion) || uVersion != SCENE_VERSION)
+		return false;
+
+	//read into a scene of our own so a bad file leaves this one untouched
+	MyScene scene;
+	uint uPrototypeCount = 0;
+	if (!snapshot.Read(uPrototypeCount))
+		return false;
+	for (uint i = 0; i < uPrototypeCount; ++i)
+	{
+		String sFileName;
+		if (!snapshot.ReadString(sFileName))
+			return false;
+		scene.m_PrototypeList.push_back(sFileName);
+	}
+
+	uint uEntityCount = 0;
+	if (!snapshot.Read(uEntityCount))
+		return false;
+	//every entity takes more than a byte, a count past the size of the file is a broken file
+	if (uEntityCount > snapshot.GetSize())
+		return false;
+	scene.m_EntityList.resize(uEntityCount);
+	for (uint i = 0; i < uEntityCount; ++i)
+	{
+		MySceneEntity& entity = scene.m_EntityList[i];
+		if (!snapshot.ReadString(entity.m_sUniqueID) ||
+			!snapshot.Read(entity.m_uPrototype) ||
+			!snapshot.Read(entity.m_v3Position) ||
+			!snapshot.Read(entity.m_qRotation) ||
+			!snapshot.Read(entity.m_v3Scale) ||
+			!snapshot.Read(entity.m_bPhysics) ||
+			!snapshot.Read(entity.m_fMass))
+			return false;
+	}
+	if (!scene.IsValid())
+		return false;
+
+	Swap(scene);
+	return true;
+}
+bool MyScene::SaveText(String a_sFileName)
+{
+	std::ofstream file(a_sFileName);
+	if (!file)
+		return false;
+
+	//9 digits read back to the same float, so the text twin loads the same scene as the binary file
+	file << std::setprecision(9);
+	file << "# VoxelDodge scene " << SCENE_VERSION << "\n";
+	file << "# prototype \"<file>\"\n";
+	file << "# entity \"<id>\" <prototype> <px py pz> <qw qx qy qz> <sx sy sz> <physics> <mass>\n";
+	for (uint i = 0; i < m_PrototypeList.size(); ++i)
+		file << "prototype " << std::quoted(m_PrototypeList[i]) << "\n";
+	for (uint i = 0; i < m_EntityList.size(); ++i)
+	{
+		MySceneEntity const& entity = m_EntityList[i];
+		file << "entity " << std::quoted(entity.m_sUniqueID) << " " << entity.m_uPrototype << " " <<
+			entity.m_v3Position.x << " " << entity.m_v3Position.y << " " << entity.m_v3Position.z << " " <<
+			entity.m_qRotation.w << " " << entity.m_qRotation.x << " " << entity.m_qRotation.y << " " << entity.m_qRotation.z << " " <<
+			entity.m_v3Scale.x << " " << entity.m_v3Scale.y << " " << entity.m_v3Scale.z << " " <<
+			entity.m_bPhysics << " " << entity.m_fMass << "\n";
+	}
+	return file.good();
+}
+bool MyScene::LoadText(String a_sFileName)
+{
+	std::ifstream file(a_sFileName);
+	if (!file)
+		return false;
+
+	MyScene scene;
+	String sLine;
+	while (std::getline(file, sLine))
+	{
+		std::istringstream line(sLine);
+		String sKeyword;
+		//empty lines and comments
+		if (!(line >> sKeyword) || sKeyword[0] == '#')
+			continue;
+
+		if (sKeyword == "prototype")
+		{
+			String sFileName;
+			if (!(line >> std::quoted(sFileName)))
+				return false;
+			scene.m_PrototypeList.push_back(sFileName);
+		}
+		else if (sKeyword == "entity")
+		{
+			MySceneEntity entity;
+			if (!(line >> std::quoted(entity.m_sUniqueID) >> entity.m_uPrototype >>
+				entity.m_v3Position.x >> entity.m_v3Position.y >> entity.m_v3Position.z >>
+				entity.m_qRotation.w >> entity.m_qRotation.x >> entity.m_qRotation.y >> entity.m_qRotation.z >>
+				entity.m_v3Scale.x >> entity.m_v3Scale.y >> entity.m_v3Scale.z >>
+				entity.m_bPhysics >> entity.m_fMass))
+				return false;
+			scene.m_EntityList.push_back(entity);
+		}
+		else
+			return false;
+	}
+	if (!scene.IsValid())
+		return false;
+
+	Swap(scene);
+	return true;
+}
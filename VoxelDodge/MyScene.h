@@ -0,0 +1,176 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/07
+----------------------------------------------*/
+#ifndef __MYSCENE_H_
+#define __MYSCENE_H_
+
+#include "MySnapshot.h"
+#include <vector>
+
+namespace Simplex
+{
+
+//Version of the scene files, files of other versions are refused
+#define SCENE_VERSION 1
+
+//Everything the manager needs to place one entity of the scene
+struct MySceneEntity
+{
+	String m_sUniqueID = "NA"; //identifier wanted, the manager generates another one if it is taken
+	uint m_uPrototype = 0; //index of its model in the prototype list of the scene
+	vector3 m_v3Position = vector3(0.0f); //position in world space
+	quaternion m_qRotation = quaternion(); //orientation
+	vector3 m_v3Scale = vector3(1.0f); //scale
+	bool m_bPhysics = false; //is it moved by the physics solver?
+	float m_fMass = 1.0f; //mass of the solver
+};
+
+/*
+List of the models used (prototypes) and of the entities placed, read and written as a binary file or
+as a text twin with one line per entry for editing by hand; the manager loads it all at once with
+MyEntityManager::LoadScene
+*/
+class MyScene
+{
+	std::vector<String> m_PrototypeList; //file names of the models used
+	std::vector<MySceneEntity> m_EntityList; //entities placed
+
+public:
+	/*
+	Usage: Constructor, empty scene
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyScene(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyScene(MyScene const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyScene& operator=(MyScene const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyScene(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyScene& other);
+	/*
+	USAGE: Adds a model to the prototype list, if it is there already nothing is added
+	ARGUMENTS: String a_sFileName -> name of the model file
+	OUTPUT: index of the prototype, for MySceneEntity::m_uPrototype
+	*/
+	uint AddPrototype(String a_sFileName);
+	/*
+	USAGE: Adds an entity to the scene
+	ARGUMENTS: MySceneEntity const& a_Entity -> entity to add, its prototype has to be in the list
+	OUTPUT: ---
+	*/
+	void AddEntity(MySceneEntity const& a_Entity);
+	/*
+	USAGE: Allocates space for the entities before adding them
+	ARGUMENTS: uint a_uCapacity -> number of entities to allocate for
+	OUTPUT: ---
+	*/
+	void Reserve(uint a_uCapacity);
+	/*
+	USAGE: Empties the scene
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Gets the number of prototypes
+	ARGUMENTS: ---
+	OUTPUT: prototype count
+	*/
+	uint GetPrototypeCount(void);
+	/*
+	USAGE: Gets the file name of a prototype
+	ARGUMENTS: uint a_uIndex -> index of the prototype
+	OUTPUT: file name, blank if the index is out of bounds
+	*/
+	String GetPrototype(uint a_uIndex);
+	/*
+	USAGE: Gets the number of entities
+	ARGUMENTS: ---
+	OUTPUT: entity count
+	*/
+	uint GetEntityCount(void);
+	/*
+	USAGE: Gets an entity of the scene
+	ARGUMENTS: uint a_uIndex -> index of the entity, has to be less than the count
+	OUTPUT: entity
+	*/
+	MySceneEntity& GetEntity(uint a_uIndex);
+	/*
+	USAGE: Writes the scene to a binary file
+	ARGUMENTS: String a_sFileName -> name of the file
+	OUTPUT: could the file be written?
+	*/
+	bool Save(String a_sFileName);
+	/*
+	USAGE: Replaces the scene with the one in a binary file written by Save
+	ARGUMENTS: String a_sFileName -> name of the file
+	OUTPUT: could the file be read? the scene is left as it was if it could not
+	*/
+	bool Load(String a_sFileName);
+	/*
+	USAGE: Writes the scene to a text file, one "prototype "<file>"" line per model followed by one
+		"entity "<id>" <prototype> <position xyz> <rotation wxyz> <scale xyz> <physics> <mass>" line per
+		entity, file names and identifiers are quoted so they can have spaces
+	ARGUMENTS: String a_sFileName -> name of the file
+	OUTPUT: could the file be written?
+	*/
+	bool SaveText(String a_sFileName);
+	/*
+	USAGE: Replaces the scene with the one in a text file in the format of SaveText, empty lines and
+		lines starting with # are skipped
+	ARGUMENTS: String a_sFileName -> name of the file
+	OUTPUT: could the file be read? the scene is left as it was if it could not
+	*/
+	bool LoadText(String a_sFileName);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+	/*
+	Usage: Asks if every prototype has a file name and every entity has an identifier and uses a
+		prototype of the list, for scenes read from files
+	Arguments: ---
+	Output: is it valid?
+	*/
+	bool IsValid(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSCENE_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
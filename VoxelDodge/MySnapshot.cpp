@@ -0,0 +1,78 @@
+#include "MySnapshot.h"
+#include <fstream>
+using namespace Simplex;
+//  MySnapshot
+void MySnapshot::Init(void)
+{
+	m_Buffer.clear();
+	m_uOffset = 0;
+}
+void MySnapshot::Swap(MySnapshot& other)
+{
+	std::swap(m_Buffer, other.m_Buffer);
+	std::swap(m_uOffset, other.m_uOffset);
+}
+void MySnapshot::Release(void){/*the vector releases itself*/ }
+//The big 3
+MySnapshot::MySnapshot(void){ Init(); }
+MySnapshot::MySnapshot(MySnapshot const& other)
+{
+	m_Buffer = other.m_Buffer;
+	m_uOffset = other.m_uOffset;
+}
+MySnapshot& MySnapshot::operator=(MySnapshot const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MySnapshot temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MySnapshot::~MySnapshot() { Release(); }
+
+//Accessors
+void MySnapshot::WriteString(String a_sValue)
+{
+	Write(static_cast<uint>(a_sValue.size()));
+	m_Buffer.insert(m_Buffer.end(), a_sValue.begin(), a_sValue.end());
+}
+bool MySnapshot::ReadString(String& a_sValue)
+{
+	uint uLength = 0;
+	if (!Read(uLength) || m_uOffset + uLength > m_Buffer.size())
+		return false;
+	a_sValue.assign(m_Buffer.begin() + m_uOffset, m_Buffer.begin() + m_uOffset + uLength);
+	m_uOffset += uLength;
+	return true;
+}
+void MySnapshot::Clear(void) { Init(); }
+void MySnapshot::Seek(uint a_uOffset) { m_uOffset = std::min(a_uOffset, static_cast<uint>(m_Buffer.size())); }
+uint MySnapshot::GetOffset(void) { return m_uOffset; }
+bool MySnapshot::IsEmpty(void) { return m_Buffer.empty(); }
+uint MySnapshot::GetSize(void) { return static_cast<uint>(m_Buffer.size()); }
+bool MySnapshot::SaveFile(String a_sFileName)
+{
+	std::ofstream file(a_sFileName, std::ios::binary);
+	if (!file)
+		return false;
+	if (!m_Buffer.empty())
+		file.write(&m_Buffer[0], m_Buffer.size());
+	return file.good();
+}
+bool MySnapshot::LoadFile(String a_sFileName)
+{
+	std::ifstream file(a_sFileName, std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+	std::streamsize size = file.tellg();
+	file.seekg(0, std::ios::beg);
+	std::vector<char> buffer(static_cast<size_t>(size));
+	if (size > 0 && !file.read(&buffer[0], size))
+		return false;
+	m_Buffer.swap(buffer);
+	m_uOffset = 0;
+	return true;
+}
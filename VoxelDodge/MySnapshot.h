@@ -0,0 +1,157 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/07
+----------------------------------------------*/
+#ifndef __MYSNAPSHOT_H_
+#define __MYSNAPSHOT_H_
+
+#include "Simplex\Simplex.h"
+#include <vector>
+
+namespace Simplex
+{
+
+//Binary buffer the simulation state is written to and read back from, writes append and reads move
+//forward so several parts can share one buffer, values are stored as their raw bytes so a snapshot
+//only reads back on the same build and platform that wrote it
+class MySnapshot
+{
+	std::vector<char> m_Buffer; //bytes written so far
+	uint m_uOffset = 0; //position the next read starts at
+
+public:
+	/*
+	Usage: Constructor, empty buffer
+	Arguments: ---
+	Output: class object instance
+	*/
+	MySnapshot(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MySnapshot(MySnapshot const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MySnapshot& operator=(MySnapshot const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MySnapshot(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MySnapshot& other);
+	/*
+	USAGE: Appends the bytes of a value, only for numbers and vectors, structs go field by field so
+		their padding and pointers never reach the buffer
+	ARGUMENTS: T const& a_Value -> value to write
+	OUTPUT: ---
+	*/
+	template <class T>
+	void Write(T const& a_Value)
+	{
+		char const* pBytes = reinterpret_cast<char const*>(&a_Value);
+		m_Buffer.insert(m_Buffer.end(), pBytes, pBytes + sizeof(T));
+	}
+	/*
+	USAGE: Reads a value written by Write and moves past it
+	ARGUMENTS: T& a_Value -> (output) value read, untouched if the buffer is too short
+	OUTPUT: was there enough data?
+	*/
+	template <class T>
+	bool Read(T& a_Value)
+	{
+		if (m_uOffset + sizeof(T) > m_Buffer.size())
+			return false;
+		memcpy(&a_Value, &m_Buffer[m_uOffset], sizeof(T));
+		m_uOffset += sizeof(T);
+		return true;
+	}
+	/*
+	USAGE: Appends a string as its length followed by its characters
+	ARGUMENTS: String a_sValue -> string to write
+	OUTPUT: ---
+	*/
+	void WriteString(String a_sValue);
+	/*
+	USAGE: Reads a string written by WriteString and moves past it
+	ARGUMENTS: String& a_sValue -> (output) string read
+	OUTPUT: was there enough data?
+	*/
+	bool ReadString(String& a_sValue);
+	/*
+	USAGE: Empties the buffer
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Clear(void);
+	/*
+	USAGE: Moves the reading position, to read the buffer again from the start or from a saved offset
+	ARGUMENTS: uint a_uOffset = 0 -> byte the next read starts at
+	OUTPUT: ---
+	*/
+	void Seek(uint a_uOffset = 0);
+	/*
+	USAGE: Gets the byte the next read starts at
+	ARGUMENTS: ---
+	OUTPUT: reading position
+	*/
+	uint GetOffset(void);
+	/*
+	USAGE: Asks if there is something written in the buffer
+	ARGUMENTS: ---
+	OUTPUT: is it empty?
+	*/
+	bool IsEmpty(void);
+	/*
+	USAGE: Gets the number of bytes written
+	ARGUMENTS: ---
+	OUTPUT: size in bytes
+	*/
+	uint GetSize(void);
+	/*
+	USAGE: Writes the buffer to a file
+	ARGUMENTS: String a_sFileName -> name of the file
+	OUTPUT: could the file be written?
+	*/
+	bool SaveFile(String a_sFileName);
+	/*
+	USAGE: Replaces the buffer with the contents of a file, reading starts at its first byte
+	ARGUMENTS: String a_sFileName -> name of the file
+	OUTPUT: could the file be read?
+	*/
+	bool LoadFile(String a_sFileName);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYSNAPSHOT_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
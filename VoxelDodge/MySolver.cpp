@@ -5,15 +5,27 @@ void MySolver::Init(void)
 {
 	m_v3Acceleration = ZERO_V3;
 	m_v3Position = ZERO_V3;
+	m_v3Size = vector3(1.0f);
 	m_v3Velocity = ZERO_V3;
 	m_fMass = 1.0f;
+	m_bAwake = true;
+	m_uRestFrames = 0;
+	m_v3Push = ZERO_V3;
+	m_fFloorImpulse = 0.0f;
+	m_fFloorPush = 0.0f;
 }
 void MySolver::Swap(MySolver& other)
 {
 	std::swap(m_v3Acceleration, other.m_v3Acceleration);
 	std::swap(m_v3Velocity, other.m_v3Velocity);
 	std::swap(m_v3Position, other.m_v3Position);
+	std::swap(m_v3Size, other.m_v3Size);
 	std::swap(m_fMass, other.m_fMass);
+	std::swap(m_bAwake, other.m_bAwake);
+	std::swap(m_uRestFrames, other.m_uRestFrames);
+	std::swap(m_v3Push, other.m_v3Push);
+	std::swap(m_fFloorImpulse, other.m_fFloorImpulse);
+	std::swap(m_fFloorPush, other.m_fFloorPush);
 }
 void MySolver::Release(void){/*nothing to deallocate*/ }
 //The big 3
@@ -23,7 +35,13 @@ MySolver::MySolver(MySolver const& other)
 	m_v3Acceleration = other.m_v3Acceleration;
 	m_v3Velocity = other.m_v3Velocity;
 	m_v3Position = other.m_v3Position;
+	m_v3Size = other.m_v3Size;
 	m_fMass = other.m_fMass;
+	m_bAwake = other.m_bAwake;
+	m_uRestFrames = other.m_uRestFrames;
+	m_v3Push = other.m_v3Push;
+	m_fFloorImpulse = other.m_fFloorImpulse;
+	m_fFloorPush = other.m_fFloorPush;
 }
 MySolver& MySolver::operator=(MySolver const& other)
 {
@@ -39,17 +57,34 @@ MySolver& MySolver::operator=(MySolver const& other)
 MySolver::~MySolver() { Release(); }
 
 //Accessors
-void MySolver::SetPosition(vector3 a_v3Position) { m_v3Position = a_v3Position; }
+void MySolver::SetPosition(vector3 a_v3Position) { m_v3Position = a_v3Position; Wake(); }
 vector3 MySolver::GetPosition(void) { return m_v3Position; }
 
 void MySolver::SetSize(vector3 a_v3Size) { m_v3Size = a_v3Size; }
 vector3 MySolver::GetSize(void) { return m_v3Size; }
 
-void MySolver::SetVelocity(vector3 a_v3Velocity) { m_v3Velocity = a_v3Velocity; }
+void MySolver::SetVelocity(vector3 a_v3Velocity) { m_v3Velocity = a_v3Velocity; Wake(); }
 vector3 MySolver::GetVelocity(void) { return m_v3Velocity; }
 
 void MySolver::SetMass(float a_fMass) { m_fMass = a_fMass; }
 float MySolver::GetMass(void) { return m_fMass; }
+float MySolver::GetInverseMass(void) { return 1.0f / (m_fMass < 0.01f ? 0.01f : m_fMass); }
+
+bool MySolver::IsAwake(void) { return m_bAwake; }
+bool MySolver::IsResting(void) { return m_uRestFrames > 0; }
+bool MySolver::CanSleep(void) { return m_uRestFrames >= SOLVER_SLEEP_FRAMES; }
+void MySolver::Wake(void)
+{
+	m_bAwake = true;
+	m_uRestFrames = 0;
+}
+void MySolver::Sleep(void)
+{
+	m_bAwake = false;
+	m_uRestFrames = 0;
+	m_v3Velocity = ZERO_V3;
+	m_v3Acceleration = ZERO_V3;
+}
 
 //Methods
 void MySolver::ApplyFriction(float a_fFriction)
@@ -70,15 +105,28 @@ void MySolver::ApplyForce(vector3 a_v3Force)
 		m_fMass = 0.01f;
 	//f = m * a -> a = f / m
 	m_v3Acceleration += a_v3Force / m_fMass;
+	Wake();
 }
-vector3 CalculateMaxVelocity(vector3 a_v3Velocity, float maxVelocity)
+void MySolver::ApplyImpulse(vector3 a_v3Impulse)
 {
-	if (glm::length(a_v3Velocity) > maxVelocity)
-	{
-		a_v3Velocity = glm::normalize(a_v3Velocity);
-		a_v3Velocity *= maxVelocity;
-	}
-	return a_v3Velocity;
+	m_v3Velocity += a_v3Impulse * GetInverseMass();
+}
+void MySolver::ApplyPushImpulse(vector3 a_v3Impulse)
+{
+	m_v3Push += a_v3Impulse * GetInverseMass();
+}
+vector3 MySolver::GetPush(void) { return m_v3Push; }
+void MySolver::SolveFloor(void)
+{
+	//the floor can only push up, at most enough to land on it this frame
+	float fOldImpulse = m_fFloorImpulse;
+	m_fFloorImpulse = std::max(fOldImpulse - m_v3Position.y - m_v3Velocity.y, 0.0f);
+	m_v3Velocity.y += m_fFloorImpulse - fOldImpulse;
+
+	//same for the push, on top of where the velocity is taking the solver
+	float fOldPush = m_fFloorPush;
+	m_fFloorPush = std::max(fOldPush - m_v3Position.y - m_v3Velocity.y - m_v3Push.y, 0.0f);
+	m_v3Push.y += m_fFloorPush - fOldPush;
 }
 vector3 RoundSmallVelocity(vector3 a_v3Velocity, float minVelocity = 0.01f)
 {
@@ -88,19 +136,26 @@ vector3 RoundSmallVelocity(vector3 a_v3Velocity, float minVelocity = 0.01f)
 	}
 	return a_v3Velocity;
 }
-void MySolver::Update(void)
+void MySolver::IntegrateVelocity(void)
 {
-	ApplyForce(vector3(0.0f, -0.035f, 0.0f));
+	//gravity does not go through ApplyForce, it would keep the solver from ever resting
+	m_v3Acceleration += vector3(0.0f, -0.035f, 0.0f) * GetInverseMass();
 
+	//no cap on the velocity, the entity manager sweeps the fast solvers so they do not tunnel
 	m_v3Velocity += m_v3Acceleration;
-	
-	float fMaxVelocity = 5.0f;
-	m_v3Velocity = CalculateMaxVelocity(m_v3Velocity, fMaxVelocity);
 
 	ApplyFriction(0.1f);
 	m_v3Velocity = RoundSmallVelocity(m_v3Velocity, 0.028f);
 
-	m_v3Position += m_v3Velocity;
+	m_v3Acceleration = ZERO_V3;
+	m_v3Push = ZERO_V3;
+	m_fFloorImpulse = 0.0f;
+	m_fFloorPush = 0.0f;
+}
+void MySolver::IntegratePosition(float a_fTime)
+{
+	vector3 v3Start = m_v3Position;
+	m_v3Position += (m_v3Velocity + m_v3Push) * a_fTime;
 			
 	if (m_v3Position.y <= 0)
 	{
@@ -108,26 +163,49 @@ void MySolver::Update(void)
 		m_v3Velocity.y = 0;
 	}
 
-	m_v3Acceleration = ZERO_V3;
-}
-void MySolver::ResolveCollision(MySolver* a_pOther)
-{
-	float fMagThis = glm::length(m_v3Velocity);
-	float fMagOther = glm::length(m_v3Velocity);
-
-	if (fMagThis > 0.015f || fMagOther > 0.015f)
+	//a body has to rest for a while before it sleeps so a bounce at the top of its arc does not count,
+	//the push counts as moving so a body does not sleep halfway out of a penetration
+	if (glm::length(m_v3Velocity) < SOLVER_SLEEP_VELOCITY &&
+		glm::distance(v3Start, m_v3Position) < SOLVER_SLEEP_VELOCITY * a_fTime)
 	{
-		//a_pOther->ApplyForce(GetVelocity());
-		ApplyForce(-m_v3Velocity);
-		a_pOther->ApplyForce(m_v3Velocity);
+		if (m_uRestFrames < SOLVER_SLEEP_FRAMES)
+			++m_uRestFrames;
 	}
 	else
 	{
-		vector3 v3Direction = m_v3Position - a_pOther->m_v3Position;
-		if(glm::length(v3Direction) != 0)
-			v3Direction = glm::normalize(v3Direction);
-		v3Direction *= 0.04f;
-		ApplyForce(v3Direction);
-		a_pOther->ApplyForce(-v3Direction);
+		m_uRestFrames = 0;
 	}
-}
\ No newline at end of file
+}
+void MySolver::Update(void)
+{
+	IntegrateVelocity();
+	IntegratePosition();
+	if (CanSleep())
+		Sleep();
+}
+void MySolver::Save(MySnapshot& a_Snapshot)
+{
+	a_Snapshot.Write(m_v3Acceleration);
+	a_Snapshot.Write(m_v3Position);
+	a_Snapshot.Write(m_v3Size);
+	a_Snapshot.Write(m_v3Velocity);
+	a_Snapshot.Write(m_fMass);
+	a_Snapshot.Write(m_bAwake);
+	a_Snapshot.Write(m_uRestFrames);
+	a_Snapshot.Write(m_v3Push);
+	a_Snapshot.Write(m_fFloorImpulse);
+	a_Snapshot.Write(m_fFloorPush);
+}
+bool MySolver::Load(MySnapshot& a_Snapshot)
+{
+	return a_Snapshot.Read(m_v3Acceleration) &&
+		a_Snapshot.Read(m_v3Position) &&
+		a_Snapshot.Read(m_v3Size) &&
+		a_Snapshot.Read(m_v3Velocity) &&
+		a_Snapshot.Read(m_fMass) &&
+		a_Snapshot.Read(m_bAwake) &&
+		a_Snapshot.Read(m_uRestFrames) &&
+		a_Snapshot.Read(m_v3Push) &&
+		a_Snapshot.Read(m_fFloorImpulse) &&
+		a_Snapshot.Read(m_fFloorPush);
+}
@@ -6,9 +6,14 @@ Date: 2017/07
 #define __MYSOLVER_H_
 
 #include "MyRigidBody.h"
+#include "MySnapshot.h"
 
 namespace Simplex
 {
+//Speed under which a body counts as resting
+#define SOLVER_SLEEP_VELOCITY 0.01f
+//Consecutive frames a body has to rest before it falls asleep
+#define SOLVER_SLEEP_FRAMES 30
 
 class MySolver
 {
@@ -17,6 +22,11 @@ class MySolver
 	vector3 m_v3Size = vector3(1.0f); //Size of the MySolver
 	vector3 m_v3Velocity = ZERO_V3; //Velocity of the MySolver
 	float m_fMass = 1.0f; //Mass of the solver
+	bool m_bAwake = true; //Is the solver integrating? sleeping solvers keep their state untouched
+	uint m_uRestFrames = 0; //Consecutive frames the solver has been under the sleep velocity
+	vector3 m_v3Push = ZERO_V3; //Velocity that only corrects the position this frame, it is not kept as momentum
+	float m_fFloorImpulse = 0.0f; //Upward velocity the floor has given the solver this frame
+	float m_fFloorPush = 0.0f; //Upward push the floor has given the solver this frame
 public:
 	/*
 	USAGE: Constructor
@@ -108,23 +118,107 @@ public:
 	*/
 	void ApplyFriction(float a_fFriction = 0.1f);
 	/*
-	USAGE: Applies a force to the solver
+	USAGE: Applies a force to the solver, waking it up
 	ARGUMENTS: vector3 a_v3Force -> Force to apply
 	OUTPUT: ---
 	*/
 	void ApplyForce(vector3 a_v3Force);
 	/*
-	USAGE: Updates the MySolver
+	USAGE: Changes the velocity of the solver by an impulse, the contact solver uses it
+	ARGUMENTS: vector3 a_v3Impulse -> Impulse to apply
+	OUTPUT: ---
+	*/
+	void ApplyImpulse(vector3 a_v3Impulse);
+	/*
+	USAGE: Keeps the velocity and the push from taking the solver under the floor, the contact solver
+		calls it after its impulses so the floor holds up whatever rests on this solver, what the floor
+		gave is accumulated so it can be taken back when the contacts stop pushing down
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void SolveFloor(void);
+	/*
+	USAGE: Changes the push of the solver by an impulse, the push moves the solver this frame only so
+		the contact solver can take it out of a penetration without making it bounce
+	ARGUMENTS: vector3 a_v3Impulse -> Impulse to apply
+	OUTPUT: ---
+	*/
+	void ApplyPushImpulse(vector3 a_v3Impulse);
+	/*
+	USAGE: Gets the push of the solver this frame
+	ARGUMENTS: ---
+	OUTPUT: push velocity
+	*/
+	vector3 GetPush(void);
+	/*
+	USAGE: Gets the inverse of the mass of the solver
+	ARGUMENTS: ---
+	OUTPUT: 1 / mass
+	*/
+	float GetInverseMass(void);
+	/*
+	USAGE: Asks if the solver is awake
+	ARGUMENTS: ---
+	OUTPUT: is it integrating?
+	*/
+	bool IsAwake(void);
+	/*
+	USAGE: Asks if the solver was under the sleep velocity the last frame, on its way to sleep
+	ARGUMENTS: ---
+	OUTPUT: is it resting?
+	*/
+	bool IsResting(void);
+	/*
+	USAGE: Asks if the solver has been resting for SOLVER_SLEEP_FRAMES, whoever owns it decides
+		when it actually sleeps
+	ARGUMENTS: ---
+	OUTPUT: is it ready to sleep?
+	*/
+	bool CanSleep(void);
+	/*
+	USAGE: Wakes the solver up and restarts its rest count
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Wake(void);
+	/*
+	USAGE: Puts the solver to sleep, it will stop moving until something wakes it up
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void Sleep(void);
+	/*
+	USAGE: First half of the step, applies the forces, gravity and friction to the velocity
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void IntegrateVelocity(void);
+	/*
+	USAGE: Second half of the step, moves the solver with its velocity and push and counts the frames
+		it has been resting
+	ARGUMENTS: float a_fTime = 1.0f -> fraction of the frame to move, to move a fast solver in substeps
+	OUTPUT: ---
+	*/
+	void IntegratePosition(float a_fTime = 1.0f);
+	/*
+	USAGE: Updates the MySolver, both halves of the step with no contacts in between, sleeps on its
+		own once it can
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
-	USAGE: Resolve the collision between two solvers
-	ARGUMENTS: MySolver* a_pOther -> other solver to resolve collision with
+	USAGE: Writes the state of the solver to the snapshot
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to write to
 	OUTPUT: ---
 	*/
-	void ResolveCollision(MySolver* a_pOther);
+	void Save(MySnapshot& a_Snapshot);
+	/*
+	USAGE: Reads the state written by Save
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to read from
+	OUTPUT: was the state there?
+	*/
+	bool Load(MySnapshot& a_Snapshot);
 private:
 	/*
 	Usage: Deallocates member fields
@@ -0,0 +1,171 @@
+#include "MyTransform.h"
+using namespace Simplex;
+//  MyTransform
+void MyTransform::Init(void)
+{
+	m_v3Position = ZERO_V3;
+	m_qRotation = quaternion();
+	m_v3Scale = vector3(1.0f);
+	m_m4ToWorld = IDENTITY_M4;
+	m_bMatrixDirty = false;
+	m_uChange = TRANSFORM_NONE;
+}
+void MyTransform::Swap(MyTransform& other)
+{
+	std::swap(m_v3Position, other.m_v3Position);
+	std::swap(m_qRotation, other.m_qRotation);
+	std::swap(m_v3Scale, other.m_v3Scale);
+	std::swap(m_m4ToWorld, other.m_m4ToWorld);
+	std::swap(m_bMatrixDirty, other.m_bMatrixDirty);
+	std::swap(m_uChange, other.m_uChange);
+}
+void MyTransform::Release(void){/*nothing to deallocate*/ }
+//The big 3
+MyTransform::MyTransform(void){ Init(); }
+MyTransform::MyTransform(MyTransform const& other)
+{
+	m_v3Position = other.m_v3Position;
+	m_qRotation = other.m_qRotation;
+	m_v3Scale = other.m_v3Scale;
+	m_m4ToWorld = other.m_m4ToWorld;
+	m_bMatrixDirty = other.m_bMatrixDirty;
+	m_uChange = other.m_uChange;
+}
+MyTransform& MyTransform::operator=(MyTransform const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyTransform temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+MyTransform::~MyTransform() { Release(); }
+
+//Accessors
+void MyTransform::SetPosition(vector3 a_v3Position)
+{
+	if (a_v3Position == m_v3Position)
+		return;
+	m_v3Position = a_v3Position;
+	m_bMatrixDirty = true;
+	m_uChange |= TRANSFORM_POSITION;
+}
+vector3 MyTransform::GetPosition(void) { return m_v3Position; }
+void MyTransform::SetRotation(quaternion a_qRotation)
+{
+	if (a_qRotation == m_qRotation)
+		return;
+	m_qRotation = a_qRotation;
+	m_bMatrixDirty = true;
+	m_uChange |= TRANSFORM_ROTATION;
+}
+quaternion MyTransform::GetRotation(void) { return m_qRotation; }
+void MyTransform::SetScale(vector3 a_v3Scale)
+{
+	if (a_v3Scale == m_v3Scale)
+		return;
+	m_v3Scale = a_v3Scale;
+	m_bMatrixDirty = true;
+	m_uChange |= TRANSFORM_SCALE;
+}
+vector3 MyTransform::GetScale(void) { return m_v3Scale; }
+uint MyTransform::GetChange(void) { return m_uChange; }
+void MyTransform::ClearChange(void) { m_uChange = TRANSFORM_NONE; }
+void MyTransform::Save(MySnapshot& a_Snapshot)
+{
+	a_Snapshot.Write(m_v3Position);
+	a_Snapshot.Write(m_qRotation);
+	a_Snapshot.Write(m_v3Scale);
+	a_Snapshot.Write(m_m4ToWorld);
+	a_Snapshot.Write(m_bMatrixDirty);
+}
+bool MyTransform::Load(MySnapshot& a_Snapshot)
+{
+	vector3 v3Position;
+	quaternion qRotation;
+	vector3 v3Scale;
+	matrix4 m4ToWorld;
+	bool bMatrixDirty;
+	if (!a_Snapshot.Read(v3Position) || !a_Snapshot.Read(qRotation) || !a_Snapshot.Read(v3Scale) ||
+		!a_Snapshot.Read(m4ToWorld) || !a_Snapshot.Read(bMatrixDirty))
+		return false;
+
+	if (v3Position != m_v3Position || m4ToWorld != m_m4ToWorld)
+		m_uChange |= TRANSFORM_POSITION;
+	if (qRotation != m_qRotation)
+		m_uChange |= TRANSFORM_ROTATION;
+	if (v3Scale != m_v3Scale)
+		m_uChange |= TRANSFORM_SCALE;
+
+	//the matrix is restored as it was, composing it again could round it differently
+	m_v3Position = v3Position;
+	m_qRotation = qRotation;
+	m_v3Scale = v3Scale;
+	m_m4ToWorld = m4ToWorld;
+	m_bMatrixDirty = bMatrixDirty;
+	return true;
+}
+
+//Methods
+void MyTransform::SetMatrix(matrix4 a_m4ToWorld)
+{
+	if (!m_bMatrixDirty && a_m4ToWorld == m_m4ToWorld)
+		return;
+
+	//the columns of the matrix are the scaled axes, no need for a full decomposition
+	vector3 v3Position = vector3(a_m4ToWorld[3]);
+	vector3 v3Scale = vector3(glm::length(vector3(a_m4ToWorld[0])),
+		glm::length(vector3(a_m4ToWorld[1])),
+		glm::length(vector3(a_m4ToWorld[2])));
+	quaternion qRotation = m_qRotation;
+	if (v3Scale.x > 0.0f && v3Scale.y > 0.0f && v3Scale.z > 0.0f)
+	{
+		matrix3 m3Rotation = matrix3(vector3(a_m4ToWorld[0]) / v3Scale.x,
+			vector3(a_m4ToWorld[1]) / v3Scale.y,
+			vector3(a_m4ToWorld[2]) / v3Scale.z);
+		qRotation = glm::quat_cast(m3Rotation);
+	}
+
+	SetPosition(v3Position);
+	SetRotation(qRotation);
+	SetScale(v3Scale);
+
+	//keep the matrix as given, recomposing could round it differently
+	m_m4ToWorld = a_m4ToWorld;
+	m_bMatrixDirty = false;
+}
+matrix4 MyTransform::GetMatrix(void)
+{
+	if (m_bMatrixDirty)
+	{
+		//translate * rotate * scale written directly, the rotation columns are scaled in place
+		matrix3 m3Rotation = glm::mat3_cast(m_qRotation);
+		m_m4ToWorld = matrix4(vector4(m3Rotation[0] * m_v3Scale.x, 0.0f),
+			vector4(m3Rotation[1] * m_v3Scale.y, 0.0f),
+			vector4(m3Rotation[2] * m_v3Scale.z, 0.0f),
+			vector4(m_v3Position, 1.0f));
+		m_bMatrixDirty = false;
+	}
+	return m_m4ToWorld;
+}
+void MyTransform::GetARBB(vector3 a_v3CenterL, vector3 a_v3HalfWidthL, vector3& a_v3MinG, vector3& a_v3MaxG)
+{
+	GetARBB(GetMatrix(), a_v3CenterL, a_v3HalfWidthL, a_v3MinG, a_v3MaxG);
+}
+void MyTransform::GetARBB(matrix4 a_m4ToWorld, vector3 a_v3CenterL, vector3 a_v3HalfWidthL, vector3& a_v3MinG, vector3& a_v3MaxG)
+{
+	vector3 v3CenterG = vector3(a_m4ToWorld * vector4(a_v3CenterL, 1.0f));
+
+	//each world half width is the local half widths projected on that axis, the absolute
+	//value of the rotation and scale part gives the farthest corner without visiting all 8
+	matrix3 m3Abs = matrix3(glm::abs(vector3(a_m4ToWorld[0])),
+		glm::abs(vector3(a_m4ToWorld[1])),
+		glm::abs(vector3(a_m4ToWorld[2])));
+	vector3 v3HalfWidthG = m3Abs * a_v3HalfWidthL;
+
+	a_v3MinG = v3CenterG - v3HalfWidthG;
+	a_v3MaxG = v3CenterG + v3HalfWidthG;
+}
@@ -0,0 +1,185 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/07
+----------------------------------------------*/
+#ifndef __MYTRANSFORM_H_
+#define __MYTRANSFORM_H_
+
+#include "Simplex\Mesh\Model.h"
+#include "MySnapshot.h"
+
+namespace Simplex
+{
+
+//Parts of a transform that changed, so the systems that read it only redo what they need
+enum eTRANSFORM_CHANGE
+{
+	TRANSFORM_NONE = 0,
+	TRANSFORM_POSITION = 1,
+	TRANSFORM_ROTATION = 2,
+	TRANSFORM_SCALE = 4
+};
+
+//Position, rotation and scale of an object, the model matrix is composed from them when asked for
+class MyTransform
+{
+	vector3 m_v3Position = ZERO_V3; //position in world space
+	quaternion m_qRotation = quaternion(); //orientation
+	vector3 m_v3Scale = vector3(1.0f); //scale on each local axis
+
+	matrix4 m_m4ToWorld = IDENTITY_M4; //composed model matrix, valid while m_bMatrixDirty is false
+	bool m_bMatrixDirty = false; //does the model matrix need to be composed again?
+	uint m_uChange = TRANSFORM_NONE; //parts changed since ClearChange, combination of eTRANSFORM_CHANGE
+
+public:
+	/*
+	Usage: Constructor, identity transform
+	Arguments: ---
+	Output: class object instance
+	*/
+	MyTransform(void);
+	/*
+	Usage: Copy Constructor
+	Arguments: class object to copy
+	Output: class object instance
+	*/
+	MyTransform(MyTransform const& other);
+	/*
+	Usage: Copy Assignment Operator
+	Arguments: class object to copy
+	Output: ---
+	*/
+	MyTransform& operator=(MyTransform const& other);
+	/*
+	Usage: Destructor
+	Arguments: ---
+	Output: ---
+	*/
+	~MyTransform(void);
+	/*
+	Usage: Changes object contents for other object's
+	Arguments: other -> object to swap content from
+	Output: ---
+	*/
+	void Swap(MyTransform& other);
+	/*
+	USAGE: Sets the position
+	ARGUMENTS: vector3 a_v3Position -> position in world space
+	OUTPUT: ---
+	*/
+	void SetPosition(vector3 a_v3Position);
+	/*
+	USAGE: Gets the position
+	ARGUMENTS: ---
+	OUTPUT: position in world space
+	*/
+	vector3 GetPosition(void);
+	/*
+	USAGE: Sets the orientation
+	ARGUMENTS: quaternion a_qRotation -> orientation
+	OUTPUT: ---
+	*/
+	void SetRotation(quaternion a_qRotation);
+	/*
+	USAGE: Gets the orientation
+	ARGUMENTS: ---
+	OUTPUT: orientation
+	*/
+	quaternion GetRotation(void);
+	/*
+	USAGE: Sets the scale
+	ARGUMENTS: vector3 a_v3Scale -> scale on each local axis
+	OUTPUT: ---
+	*/
+	void SetScale(vector3 a_v3Scale);
+	/*
+	USAGE: Gets the scale
+	ARGUMENTS: ---
+	OUTPUT: scale on each local axis
+	*/
+	vector3 GetScale(void);
+	/*
+	USAGE: Sets the transform from a model matrix made of a translation, a rotation and a scale,
+		the matrix is kept as given
+	ARGUMENTS: matrix4 a_m4ToWorld -> model matrix
+	OUTPUT: ---
+	*/
+	void SetMatrix(matrix4 a_m4ToWorld);
+	/*
+	USAGE: Gets the model matrix, composing it if the transform changed since it was last asked for
+	ARGUMENTS: ---
+	OUTPUT: model matrix
+	*/
+	matrix4 GetMatrix(void);
+	/*
+	USAGE: Gets the axis realigned box of a local box placed with this transform, without
+		transforming its corners
+	ARGUMENTS:
+	-	vector3 a_v3CenterL -> center of the box in local space
+	-	vector3 a_v3HalfWidthL -> half the size of the box in local space
+	-	vector3& a_v3MinG -> minimum corner of the box in world space
+	-	vector3& a_v3MaxG -> maximum corner of the box in world space
+	OUTPUT: ---
+	*/
+	void GetARBB(vector3 a_v3CenterL, vector3 a_v3HalfWidthL, vector3& a_v3MinG, vector3& a_v3MaxG);
+	/*
+	USAGE: Gets the axis realigned box of a local box placed with a model matrix, using the absolute
+		value of its rotation and scale part instead of transforming the 8 corners
+	ARGUMENTS:
+	-	matrix4 a_m4ToWorld -> model matrix
+	-	vector3 a_v3CenterL -> center of the box in local space
+	-	vector3 a_v3HalfWidthL -> half the size of the box in local space
+	-	vector3& a_v3MinG -> minimum corner of the box in world space
+	-	vector3& a_v3MaxG -> maximum corner of the box in world space
+	OUTPUT: ---
+	*/
+	static void GetARBB(matrix4 a_m4ToWorld, vector3 a_v3CenterL, vector3 a_v3HalfWidthL, vector3& a_v3MinG, vector3& a_v3MaxG);
+	/*
+	USAGE: Gets the parts that changed since the last ClearChange
+	ARGUMENTS: ---
+	OUTPUT: combination of eTRANSFORM_CHANGE
+	*/
+	uint GetChange(void);
+	/*
+	USAGE: Marks every part as up to date for the systems reading the transform
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ClearChange(void);
+	/*
+	USAGE: Writes the position, rotation, scale and model matrix to the snapshot
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to write to
+	OUTPUT: ---
+	*/
+	void Save(MySnapshot& a_Snapshot);
+	/*
+	USAGE: Reads the parts written by Save, marking the ones that change
+	ARGUMENTS: MySnapshot& a_Snapshot -> snapshot to read from
+	OUTPUT: were the parts there?
+	*/
+	bool Load(MySnapshot& a_Snapshot);
+
+private:
+	/*
+	Usage: Deallocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Release(void);
+	/*
+	Usage: Allocates member fields
+	Arguments: ---
+	Output: ---
+	*/
+	void Init(void);
+};//class
+
+} //namespace Simplex
+
+#endif //__MYTRANSFORM_H_
+
+/*
+USAGE:
+ARGUMENTS: ---
+OUTPUT: ---
+*/
@@ -5,6 +5,7 @@ layout (location = 2) in vec3 UV_b;
 layout (location = 3) in vec3 Normal_b;
 layout (location = 4) in vec3 Binormal_b;
 layout (location = 5) in vec3 Tangent_b;
+layout (location = 6) in vec3 InstanceColor_b;
 
 uniform mat4 VP;
 uniform mat4 m4ToWorld[250];
@@ -16,6 +17,7 @@ out vec3 Position_W;
 out vec3 Eye_W;
 out vec2 UV;
 out vec3 Color;
+out vec3 InstanceColor;
 
 void main()
 {
@@ -23,7 +25,8 @@ void main()
 	gl_Position = (VP * m4ToWorld[gl_InstanceID]) * vec4(Position_b, 1);
 	
 	UV = UV_b.xy;
-	Color = Color_b;
+	Color = Color_b * InstanceColor_b;
+	InstanceColor = InstanceColor_b;
 
 	Position_W =	(m4ToWorld[gl_InstanceID] * vec4(Position_b,1)).xyz;
 	Normal_W =		(m4ToWorld[gl_InstanceID] * vec4(Normal_b,0)).xyz;
@@ -0,0 +1,16 @@
+#version 330
+layout (location = 0) in vec2 Position_b;
+layout (location = 1) in vec2 UV_b;
+layout (location = 2) in vec4 Color_b;
+
+uniform mat4 MVP;
+
+out vec2 UV;
+out vec3 v3Color;
+
+void main()
+{
+	gl_Position = MVP * vec4(Position_b, 0, 1);
+	v3Color = Color_b.rgb;
+	UV = UV_b;
+}
\ No newline at end of file
@@ -14,6 +14,7 @@ Date: 2017/04
 #include "BasicX\System\FileReader.h" //Reads an object and returns lines as strings
 #include "BasicX\System\Folder.h" //Sets the working directory
 #include "BasicX\System\GLSystem.h" //OpenGL 2.0 and 3.0 initialization
+#include "BasicX\System\GLStateManager.h" //Skips the OpenGL state calls that would not change anything
 
 #include "BasicX\System\ShaderManager.h" //Shader Manager, loads and manages different shader files
 #include "BasicX\System\ShaderCompiler.h" //Compiles the shader objects
@@ -49,6 +50,7 @@ namespace BasicX
 		SystemSingleton::ReleaseInstance();
 		Text::ReleaseInstance();
 		MeshManager::ReleaseInstance();
+		GLStateManager::ReleaseInstance();
 	}
 }
 #endif //__BASICXFRAMEWORK_H_
\ No newline at end of file
@@ -28,6 +28,8 @@ class BasicXDLL Material
 	String m_sMapDiffuse = "NULL";
 	String m_sMapNormal = "NULL";
 	String m_sMapSpecular = "NULL";
+
+	bool m_bMapsDirty = true; //map names changed since the last LoadMaps
 	
 public:
 	/*
@@ -224,6 +226,13 @@ public:
 	*/
 	BTO_OUTPUT LoadMaps(void);
 
+	/*
+	USAGE: Asks if the map names changed since the maps were last loaded
+	ARGUMENTS: ---
+	OUTPUT: maps need to be loaded
+	*/
+	bool AreMapsDirty(void);
+
 private:
 	/*
 	USAGE: Initializes the variables of the class
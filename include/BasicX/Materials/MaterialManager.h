@@ -79,11 +79,12 @@ public:
 	int GetMaterialCount(void);
 
 	/*
-	USAGE: Tries to load all the textures for all of the materials
-	ARGUMENTS: ---
+	USAGE: Loads the textures of the materials whose map names changed since they were last loaded
+	ARGUMENTS:
+		bool a_bAll = false -> reload every material, for when the files changed on disk
 	OUTPUT: ---
 	*/
-	void ReloadMaps(void);
+	void ReloadMaps(bool a_bAll = false);
 
 	/*
 	USAGE: Gets a copy of the material specified by name
@@ -7,6 +7,7 @@ Date: 2015/06
 
 #include "BasicX\System\SystemSingleton.h"
 #include "BasicX\System\FileReader.h"
+#include "BasicX\System\GLStateManager.h"
 #include "FreeImage\FreeImage.h"
 
 namespace BasicX
@@ -19,6 +20,9 @@ class BasicXDLL Texture
 	String m_sName = "NULL";
 	String m_sFileName = "NULL";
 	String m_sAbsoluteRoute = "";
+	FIBITMAP* m_pBitmap = nullptr; //decoded image waiting to be uploaded
+	uint m_uWidth = 0; //width of the decoded image
+	uint m_uHeight = 0; //height of the decoded image
 
 public:
 	/*
@@ -60,6 +64,35 @@ public:
 	OUTPUT: success
 	*/
 	bool LoadTexture(String a_sFileName);
+	/*
+	USAGE: Finds the file of the texture and reserves its OpenGL object with a white placeholder,
+		the image can then be decoded on any thread and uploaded later from the main thread
+	ARGUMENTS:
+		String a_sFileName -> name of the file, if path not define will look
+		under the textures folder
+	OUTPUT: the file exists
+	*/
+	bool ReserveTexture(String a_sFileName);
+	/*
+	USAGE: Reads and decodes the file into memory, does not touch OpenGL so it can be called
+		from a worker thread
+	ARGUMENTS: ---
+	OUTPUT: success
+	*/
+	bool DecodeTexture(void);
+	/*
+	USAGE: Uploads the decoded image to OpenGL with its mipmaps and frees the decoded copy,
+		needs to be called from the main thread
+	ARGUMENTS: ---
+	OUTPUT: success
+	*/
+	bool UploadTexture(void);
+	/*
+	USAGE: Returns the size in bytes of the decoded image, 0 if nothing is waiting for upload
+	ARGUMENTS: ---
+	OUTPUT: size in bytes
+	*/
+	uint GetDecodedSize(void);
 //Accessors
 	/*
 	USAGE: Returns the OpenGL Identifier
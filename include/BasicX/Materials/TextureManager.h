@@ -8,6 +8,10 @@ Date: 2015/06
 #include "BasicX\materials\Texture.h"
 #include <vector>
 #include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace BasicX
 {
@@ -15,6 +19,16 @@ namespace BasicX
 class BasicXDLL TextureManager
 {
 	std::map<String,int> m_map;//indexer
+	std::map<String,int> m_resolvedMap;//texture found for each folder and map name, -1 if none
+
+	std::thread m_worker; //decodes the textures loaded in the background
+	std::mutex m_mutex; //guards the queues
+	std::condition_variable m_condition; //wakes the worker when there is something to decode
+	std::deque<Texture*> m_decodeQueue; //textures waiting to be decoded
+	std::deque<Texture*> m_uploadQueue; //textures decoded and waiting to be uploaded
+	bool m_bWorkerRunning = false; //the worker thread was started
+	bool m_bStopWorker = false; //asks the worker thread to finish
+	uint m_uUploadBudget = 8 * 1024 * 1024; //bytes uploaded to OpenGL per frame
 
 public:
 	std::vector<Texture*> m_textureList; //Vector of Textures
@@ -44,6 +58,46 @@ public:
 	OUTPUT:
 	*/
 	int LoadTexture(String sName);	//Loads a texture and returns the ID of where its stored in the vector
+	/*
+	USAGE: Loads a texture in the background, the texture has a valid OpenGL object right away
+		but shows white until the image is decoded and uploaded by Update
+	ARGUMENTS:
+		String a_sName -> name of the file, if path not define will look under the textures folder
+	OUTPUT: index of the texture in the list, -1 if the file does not exist
+	*/
+	int LoadTextureAsync(String a_sName);
+	/*
+	USAGE: Looks for a texture next to a model, trying the folder of the model, the usual texture
+		subfolders, the fbx subfolder and the default texture folder; the result is cached so each
+		folder and name is only probed once
+	ARGUMENTS:
+		String a_sName -> name of the texture file
+		String a_sRoute -> folder of the model, empty to use the default texture folder only
+		String a_sModel -> name of the model, for the fbx subfolder
+	OUTPUT: index of the texture in the list, -1 if it was not found
+	*/
+	int ResolveTexture(String a_sName, String a_sRoute, String a_sModel);
+	/*
+	USAGE: Forgets where the textures were found so the next ResolveTexture probes the folders again
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ClearResolvedTextures(void);
+	/*
+	USAGE: Uploads the textures decoded in the background until the per frame budget is spent,
+		needs to be called from the main thread
+	ARGUMENTS: ---
+	OUTPUT: number of textures uploaded
+	*/
+	uint Update(void);
+	/*
+	USAGE: Sets how many bytes of texture data Update can send to OpenGL per frame, at least one
+		texture is uploaded per frame no matter its size
+	ARGUMENTS:
+		uint a_uBytes -> budget in bytes
+	OUTPUT: ---
+	*/
+	void SetUploadBudget(uint a_uBytes);
 
 	/*
 	USAGE:
@@ -107,6 +161,12 @@ private:
 	OUTPUT: ---
 	*/
 	void Init(void); //Initialize variables
+	/*
+	USAGE: Decodes the queued textures until asked to stop, runs on the worker thread
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void DecodeWorker(void);
 };
 
 }
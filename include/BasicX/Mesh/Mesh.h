@@ -7,6 +7,7 @@ Date: 2017/05
 
 #include "BasicX\System\SystemSingleton.h"
 #include "BasicX\System\ShaderManager.h"
+#include "BasicX\System\GLStateManager.h"
 #include "BasicX\Materials\MaterialManager.h"
 #include "BasicX\Light\LightManager.h"
 
@@ -31,13 +32,13 @@ protected:
 	
 	GLuint m_VAO = 0;			//OpenGL Vertex Array Object
 	GLuint m_VBO = 0;			//OpenGL Vertex Array Object
+	GLuint m_ColorVBO = 0;		//OpenGL buffer with the color of each instance
 
 	GLuint m_nShader = 0;	//Index of the shader
 		
 	vector3 m_v3Tint = vector3(1, 1, 1); //Color modifier
 	vector3 m_v3Wireframe = vector3(0, 1, 0); //color of the wireframe
 
-	std::vector<vector3> m_lVertex; //Composed vertex array
 	std::vector<vector3> m_lVertexPos;	//List of Vertices
 	std::vector<vector3> m_lVertexCol;	//List of Colors
 	std::vector<vector3> m_lVertexNor;	//List of Normals
@@ -77,6 +78,13 @@ protected:
 	OUTPUT: ---
 	*/
 	void DisconnectOpenGL3X(void);
+	/*
+	USAGE: Writes the attributes of each vertex one after the other the way the vertex array reads them,
+	position, color, UV, normal, binormal and tangent
+	ARGUMENTS: vector3* a_pOutput -> memory for m_uVertexCount * 6 vectors
+	OUTPUT: ---
+	*/
+	void InterleaveVertices(vector3* a_pOutput);
 #pragma endregion
 #pragma region Mesh Initialization
 	/*
@@ -114,9 +122,10 @@ protected:
 	matrix4 a_mView -> View matrix
 	float* a_fMatrixArray -> Array of matrices that represent positions
 	int a_nInstances -> Number of instances to display
+	float* a_fColorArray = nullptr -> Array of colors, one per instance, nullptr uses the wireframe color
 	OUTPUT: ---
 	*/
-	virtual void RenderWire(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances);
+	virtual void RenderWire(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, float* a_fColorArray = nullptr);
 	/*
 	USAGE: Renders the mesh a_nInstances number of times on the specified positions by the a_fMatrixArray and by the
 	provided camera view and projection
@@ -126,9 +135,26 @@ protected:
 	float* a_fMatrixArray -> Array of matrices that represent positions
 	int a_nInstances -> Number of instances to display
 	vector3 a_v3CameraPosition -> Position of the camera in world space
+	float* a_fColorArray = nullptr -> Array of colors, one per instance, nullptr for white
+	OUTPUT: ---
+	*/
+	virtual void RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition, float* a_fColorArray = nullptr);
+	/*
+	USAGE: Feeds the color of each instance to the vertex array, or white to all of them
+	ARGUMENTS:
+	float* a_fColorArray -> Array of colors, one per instance, nullptr for white
+	int a_nInstances -> Number of instances in the array
+	OUTPUT: ---
+	*/
+	void BindInstanceColors(float* a_fColorArray, int a_nInstances);
+	/*
+	USAGE: Points the instance color attribute to the first color of a section of instances
+	ARGUMENTS:
+	float* a_fColorArray -> Array of colors, nothing is done if nullptr
+	uint a_uFirstInstance -> first instance of the section
 	OUTPUT: ---
 	*/
-	virtual void RenderSolid(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances, vector3 a_v3CameraPosition);
+	void SetInstanceColorSection(float* a_fColorArray, uint a_uFirstInstance);
 #pragma endregion
 public:
 	/*
@@ -200,10 +226,12 @@ public:
 		int a_nInstances -> Number of instances to display
 		vector3 a_v3CameraPosition -> Position of the camera in world space
 		int a_RenderOption = BTO_RENDER::SOLID -> Render options SOLID | WIRE
+		float* a_fColorArray = nullptr -> Array of colors (3 floats each), one per instance, nullptr for the color of the mesh
 	OUTPUT: ---
 	*/
 	virtual void Render(matrix4 a_mProjection, matrix4 a_mView, float* a_fMatrixArray, int a_nInstances,
-						vector3 a_v3CameraPosition = vector3(0), int a_RenderOption = BTO_RENDER::RENDER_SOLID);
+						vector3 a_v3CameraPosition = vector3(0), int a_RenderOption = BTO_RENDER::RENDER_SOLID,
+						float* a_fColorArray = nullptr);
 	/*
 	USAGE: Renders the mesh a_nInstances number of times on the specified positions by the a_fMatrixArray and by the
 	provided camera view and projection
@@ -609,6 +637,26 @@ public:
 	*/
 	static void ResetRenderCallCount(void);
 #pragma endregion
+#pragma region Level of Detail
+	/*
+	USAGE: Replaces the contents of this mesh with a simplified version of the source, collapsing
+		the edges that change the shape the least (quadric error) until the triangle count is reached,
+		the material and shader of the source are kept
+	ARGUMENTS:
+	Mesh* const a_pSource -> compiled mesh to simplify, copies are simplified from their original
+	uint a_uTriangles -> number of triangles to stop at
+	OUTPUT: ---
+	*/
+	void GenerateSimplified(Mesh* const a_pSource, uint a_uTriangles);
+	/*
+	USAGE: Gets the sphere that contains every vertex of the mesh, in model space
+	ARGUMENTS:
+	vector3& a_v3Center -> center of the sphere
+	float& a_fRadius -> radius of the sphere
+	OUTPUT: ---
+	*/
+	void GetBoundingSphere(vector3& a_v3Center, float& a_fRadius);
+#pragma endregion
 };
 
 //EXPIMP_TEMPLATE template class BasicXDLL std::vector<Mesh>;
@@ -13,6 +13,23 @@ namespace BasicX
 	//MeshManager
 	class BasicXDLL MeshManager
 	{
+		//Simplified versions of a mesh and the level each of its instances used last frame
+		struct MeshLOD
+		{
+			bool m_bBuilt = false; //levels were generated, or the mesh was found too small to need them
+			vector3 m_v3Center = vector3(0.0f); //center of the bounding sphere of the mesh, in model space
+			float m_fRadius = 0.0f; //radius of the bounding sphere of the mesh, in model space
+			std::vector<Mesh*> m_lLevel; //simplified meshes, each with about half the triangles of the previous
+			std::vector<uint> m_lChoice; //level picked last frame for each instance, by position in the render list
+		};
+		//Instances of one mesh that share a render mode and level, drawn with one instanced call
+		struct InstanceBucket
+		{
+			std::vector<matrix4> m_lTransform; //transform of each instance
+			std::vector<vector3> m_lColor; //color of each instance
+			bool m_bColor = false; //at least one instance is not white
+		};
+
 		std::vector<Mesh*> m_meshList; //Lit of all the meshes added to the system
 		std::map<String, uint> m_meshNames; //map of Meshes names and corresponding indices
 		std::vector<std::vector<MeshOptions>*> m_renderOptionsList; //list of options, one for each mesh -> one for each render call
@@ -23,6 +40,16 @@ namespace BasicX
 		LightManager* m_pLightMngr = nullptr;		//Light Manager
 		CameraManager* m_pCameraMngr = nullptr;	//Camera Manager
 		Text* m_pText; //Text Singleton
+
+		std::vector<MeshLOD> m_lodList; //levels of detail, one entry for each mesh
+		std::vector<InstanceBucket> m_bucketList; //instances of the mesh being rendered, by level and render mode
+		bool m_bLOD = true; //pick a simplified level for the instances that look small on screen
+		uint m_uLODLevels = 3; //number of simplified levels generated for each mesh
+		uint m_uLODMinTriangles = 256; //meshes with fewer triangles are always drawn in full
+		float m_fLODScreenSize = 0.25f; //fraction of the screen height under which the first simplified level is used, halves for each next level
+		float m_fLODHysteresis = 0.15f; //how far past a threshold an instance has to go before it changes level
+		uint m_uTriangleCount = 0; //triangles submitted last frame
+		uint m_uFullTriangleCount = 0; //triangles last frame would have submitted without levels of detail
 	public:
 		//Singleton Methods
 		/*
@@ -223,9 +250,10 @@ namespace BasicX
 		uint a_nIndex -> index of the mesh to apply transform to
 		matrix4 a_m4Transform -> transform to apply
 		int a_Render = SOLID -> render options SOLID | WIRE
+		vector3 a_v3Color = C_WHITE -> color of this instance, multiplies the color of the mesh
 		OUTPUT: returns the name of the mesh that will render
 		*/
-		void AddMeshToRenderList(uint a_nIndex, matrix4 a_m4Transform, int a_Render = RENDER_SOLID);
+		void AddMeshToRenderList(uint a_nIndex, matrix4 a_m4Transform, int a_Render = RENDER_SOLID, vector3 a_v3Color = C_WHITE);
 		/*
 		USAGE: Applies a transform to display to the specified mesh by name, the mesh will be
 		lookout	for in the map of meshes, using the mesh index if know will result in faster
@@ -234,9 +262,10 @@ namespace BasicX
 		Strin a_sMeshName -> mesh to apply transform to
 		matrix4 a_m4Transform -> transform to apply
 		int a_Render = SOLID -> render options SOLID | WIRE
+		vector3 a_v3Color = C_WHITE -> color of this instance, multiplies the color of the mesh
 		OUTPUT: returns the name of the mesh that will render
 		*/
-		void AddMeshToRenderList(String a_sMeshName, matrix4 a_m4Transform, int a_Render = RENDER_SOLID);
+		void AddMeshToRenderList(String a_sMeshName, matrix4 a_m4Transform, int a_Render = RENDER_SOLID, vector3 a_v3Color = C_WHITE);
 		/*
 		USAGE: Applies a transform to display to the specified mesh, the mesh will be lookout
 		for in the map of meshes, using the mesh index if know will result in faster additions
@@ -244,9 +273,10 @@ namespace BasicX
 		Mesh* a_pMesh -> mesh to apply transform to
 		matrix4 a_m4Transform -> transform to apply
 		int a_Render = SOLID -> render options SOLID | WIRE
+		vector3 a_v3Color = C_WHITE -> color of this instance, multiplies the color of the mesh
 		OUTPUT: returns the name of the mesh that will render
 		*/
-		void AddMeshToRenderList(Mesh* a_pMesh, matrix4 a_m4Transform, int a_Render = RENDER_SOLID);
+		void AddMeshToRenderList(Mesh* a_pMesh, matrix4 a_m4Transform, int a_Render = RENDER_SOLID, vector3 a_v3Color = C_WHITE);
 		/*
 		USAGE: Clears the map of transforms
 		ARGUMENTS: ---
@@ -303,6 +333,35 @@ namespace BasicX
 		OUTPUT: ---
 		*/
 		void SetFont(String a_sTextureName);
+		/*
+		USAGE: Generates the simplified levels of the specified mesh, meshes are also given their levels
+			when added compiled or the first time they are rendered
+		ARGUMENTS: uint a_uMeshIndex -> mesh to simplify
+		OUTPUT: number of levels generated
+		*/
+		uint GenerateLOD(uint a_uMeshIndex);
+		/*
+		USAGE: Configures the level of detail of the instances
+		ARGUMENTS:
+		bool a_bEnabled -> pick simplified levels for small instances, false draws every instance in full
+		float a_fScreenSize = 0.25f -> fraction of the screen height under which the first simplified level
+			is used, each next level is used under half the previous size
+		float a_fHysteresis = 0.15f -> fraction past a threshold an instance has to go before it changes level
+		OUTPUT: ---
+		*/
+		void SetLOD(bool a_bEnabled, float a_fScreenSize = 0.25f, float a_fHysteresis = 0.15f);
+		/*
+		USAGE: Gets the number of triangles submitted by the last render
+		ARGUMENTS: ---
+		OUTPUT: triangle count
+		*/
+		uint GetTriangleCount(void);
+		/*
+		USAGE: Gets the number of triangles the last render would have submitted without levels of detail
+		ARGUMENTS: ---
+		OUTPUT: triangle count
+		*/
+		uint GetFullTriangleCount(void);
 	private:
 		//Rule of 3
 		/*
@@ -342,6 +401,27 @@ namespace BasicX
 		OUTPUT: ---
 		*/
 		void Release(void);
+		/*
+		USAGE: Picks the level of an instance from the size of its bounding sphere on screen, only moving
+			away from the level used last frame once it is past the threshold by the hysteresis
+		ARGUMENTS:
+		MeshLOD& a_lod -> levels of the mesh
+		uint a_uInstance -> position of the instance in the render list
+		matrix4 const& a_m4Transform -> transform of the instance
+		matrix4 const& a_m4View -> view matrix of the camera
+		matrix4 const& a_m4Projection -> projection matrix of the camera
+		OUTPUT: level, 0 for the mesh itself
+		*/
+		uint PickLOD(MeshLOD& a_lod, uint a_uInstance, matrix4 const& a_m4Transform, matrix4 const& a_m4View, matrix4 const& a_m4Projection);
+		/*
+		USAGE: Draws the instances of a bucket with one call and empties it
+		ARGUMENTS:
+		Mesh* a_pMesh -> mesh to draw
+		InstanceBucket& a_bucket -> instances to draw
+		int a_nRender -> render options SOLID | WIRE
+		OUTPUT: ---
+		*/
+		void RenderBucket(Mesh* a_pMesh, InstanceBucket& a_bucket, int a_nRender);
 	};
 
 }
@@ -7,6 +7,7 @@ Date: 2017/05
 
 #include "BasicX\System\SystemSingleton.h"
 #include "BasicX\System\ShaderManager.h"
+#include "BasicX\System\GLStateManager.h"
 #include "BasicX\Materials\MaterialManager.h"
 
 namespace BasicX
@@ -16,35 +17,46 @@ namespace BasicX
 	class BasicXDLL Text
 	{
 	protected:
-		bool m_bBinded = false; //Binded flag
+		//Interleaved vertex of a glyph, 20 bytes instead of three vector3
+		struct TextVertex
+		{
+			float m_fPosition[2]; //position in the text plane
+			float m_fUV[2]; //coordinates in the font texture
+			uint m_uColor; //RGBA8 color
+		};
+		//Glyphs of one line of text, reused while the line does not change
+		struct TextLine
+		{
+			String m_sText; //characters of the line, with its line break
+			std::vector<vector3> m_lColor; //color of each character
+			float m_fHeadY = 0.0f; //row the line starts in
+			float m_fHeadYEnd = 0.0f; //row the next line starts in
+			uint m_uFirst = 0; //first vertex of the line in the buffer
+			uint m_uCount = 0; //number of vertices of the line
+		};
 
+		bool m_bBinded = false; //Binded flag
 		uint m_uMaterialIndex = 0; //Material index of this mesh
 		uint m_uVertexCount = 0; //Number of vertices in this Mesh
-
+		uint m_uBufferCapacity = 0; //Number of vertices allocated in the OpenGL buffer
 		GLuint m_vao = 0;	//OpenGL Vertex Array Object
 		GLuint m_VBO = 0;	//OpenGL Buffer (Will hold the vertex buffer pointer)
 		GLuint m_nShader = 0;	//Index of the shader
-
+		GLint m_nMVP = -1; //location of the MVP uniform
+		GLint m_nTextureID = -1; //location of the TextureID uniform
+		uint m_uShaderReload = 0; //reload count of the shader manager when the locations were asked
 		ShaderManager* m_pShaderMngr = nullptr;	//Shader Manager
 		MaterialManager* m_pMatMngr = nullptr;		//Material Manager
-		
-		std::vector<vector3> m_lVertex; //List of vertices
-
-		std::vector<vector3> m_lVertexPos;	//List of Vertices
-		std::vector<vector3> m_lVertexCol;	//List of Colors
-		std::vector<vector3> m_lVertexUV;	//List of UVS
 
+		std::vector<TextVertex> m_lVertex; //List of vertices, same as the OpenGL buffer
+		std::vector<TextVertex> m_lGlyph; //Vertices of the line being built
+		std::vector<TextLine> m_lLine; //Lines currently in the buffer
 		vector3 m_v3Head = ZERO_V3;
-
 		static Text* m_pInstance; // Singleton pointer
 		SystemSingleton* m_pSystem = nullptr;
-
 		String m_sText = "";
-		String m_sTextPrev = "";
 		String m_sFont;
 		std::vector<vector3> m_lColor;
-		std::vector<vector3> m_lColorPrev;
-
 	public:
 		/*
 		USAGE: Gets/Constructs the singleton pointer
@@ -132,11 +144,28 @@ namespace BasicX
 		void Reset(void);
 
 		/*
-		USAGE:
+		USAGE: Adds the vertices of a character to the line being built and moves the head
 		ARGUMENTS:
+			char a_cInput -> character
+			vector3 a_v3Color = C_WHITE -> color of the character
 		OUTPUT: ---
 		*/
 		void AddCharacter(char a_cInput, vector3 a_v3Color = C_WHITE);
+		/*
+		USAGE: Brings the vertex list up to date with the text, lines that did not change keep their
+			vertices
+		ARGUMENTS:
+			uint& a_uDirtyBegin -> first vertex that changed
+			uint& a_uDirtyEnd -> one past the last vertex that changed, equal to begin if none did
+		OUTPUT: ---
+		*/
+		void BuildLines(uint& a_uDirtyBegin, uint& a_uDirtyEnd);
+		/*
+		USAGE: Asks the shader for the locations of its uniforms, again after it is relinked
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void FindUniforms(void);
 	};
 }
 
@@ -0,0 +1,9 @@
+#version 330
+out vec4 Fragment;
+uniform vec3 vWireframe;
+in vec3 InstanceColor;
+void main()
+{
+	Fragment = vec4(vWireframe * InstanceColor, 1);
+	return;
+}
\ No newline at end of file
@@ -194,8 +194,9 @@ struct BasicXDLL MeshOptions
 {
 	matrix4 m_m4Transform;
 	int m_nRender;
-	MeshOptions():m_m4Transform(IDENTITY_M4), m_nRender(RENDER_SOLID) {};
-	MeshOptions(matrix4 a_m4Transform, int a_nRender):m_m4Transform(a_m4Transform), m_nRender(a_nRender){};
+	vector3 m_v3Color; //color of this instance, multiplies the color of the mesh
+	MeshOptions():m_m4Transform(IDENTITY_M4), m_nRender(RENDER_SOLID), m_v3Color(1.0f) {};
+	MeshOptions(matrix4 a_m4Transform, int a_nRender, vector3 a_v3Color = vector3(1.0f)):m_m4Transform(a_m4Transform), m_nRender(a_nRender), m_v3Color(a_v3Color){};
 };
 /*
 USAGE: Will translate all characters in the string to upper case and return a copy string
@@ -0,0 +1,268 @@
+/*----------------------------------------------
+Programmer: Alberto Bobadilla (labigm@gmail.com)
+Date: 2017/07
+----------------------------------------------*/
+#ifndef __GLSTATEMANAGER_H_
+#define __GLSTATEMANAGER_H_
+
+#include "BasicX\System\Definitions.h"
+#include <GL\glew.h>
+
+namespace BasicX
+{
+	//Number of texture units the manager keeps track of
+	#define GL_STATE_TEXTURE_UNITS 8
+
+	//Shadow of the OpenGL state the renderers change, skips the calls that would not change anything
+	class BasicXDLL GLStateManager
+	{
+		//capabilities the manager knows about, index in m_nCapabilityArray
+		enum eCAPABILITY
+		{
+			CAPABILITY_BLEND,
+			CAPABILITY_DEPTH_TEST,
+			CAPABILITY_CULL_FACE,
+			CAPABILITY_SCISSOR_TEST,
+			CAPABILITY_POLYGON_OFFSET_LINE,
+			CAPABILITY_COUNT
+		};
+
+		static GLStateManager* m_pInstance; // Singleton pointer
+
+		GLuint m_uProgram = GL_INVALID_INDEX; //program in use, GL_INVALID_INDEX when unknown
+		GLuint m_uVertexArray = GL_INVALID_INDEX; //vertex array bound, GL_INVALID_INDEX when unknown
+		GLuint m_uActiveUnit = GL_INVALID_INDEX; //active texture unit, GL_INVALID_INDEX when unknown
+		GLuint m_uTextureArray[GL_STATE_TEXTURE_UNITS]; //2D texture bound to each unit, GL_INVALID_INDEX when unknown
+		GLenum m_ePolygonMode = GL_NONE; //polygon mode of both faces, GL_NONE when unknown
+		vector2 m_v2PolygonOffset = vector2(0.0f); //factor and units of the polygon offset
+		bool m_bPolygonOffset = false; //the polygon offset is known
+		int m_nCapabilityArray[CAPABILITY_COUNT]; //1 enabled, 0 disabled, -1 unknown
+		GLenum m_eBlendSrc = GL_NONE; //source factor of the blend function, GL_NONE when unknown
+		GLenum m_eBlendDst = GL_NONE; //destination factor of the blend function
+		GLenum m_eBlendEquation = GL_NONE; //blend equation, GL_NONE when unknown
+		GLint m_nViewportArray[4]; //x, y, width and height of the viewport
+		bool m_bViewport = false; //the viewport is known
+		GLint m_nScissorArray[4]; //x, y, width and height of the scissor box
+		bool m_bScissor = false; //the scissor box is known
+
+		uint m_uCallCount = 0; //calls sent to the driver this frame
+		uint m_uSavedCount = 0; //calls skipped this frame
+		uint m_uLastCallCount = 0; //calls sent to the driver the last frame
+		uint m_uLastSavedCount = 0; //calls skipped the last frame
+
+	public:
+		/*
+		USAGE: Gets/Constructs the singleton pointer
+		ARGUMENTS: ---
+		OUTPUT: singleton
+		*/
+		static GLStateManager* GetInstance(void);
+		/*
+		USAGE: Destroys the singleton
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void ReleaseInstance(void);
+		/*
+		USAGE: glUseProgram if the program is not in use already
+		ARGUMENTS: GLuint a_uProgram -> program to use
+		OUTPUT: ---
+		*/
+		void UseProgram(GLuint a_uProgram);
+		/*
+		USAGE: glBindVertexArray if the vertex array is not bound already
+		ARGUMENTS: GLuint a_uVertexArray -> vertex array to bind
+		OUTPUT: ---
+		*/
+		void BindVertexArray(GLuint a_uVertexArray);
+		/*
+		USAGE: Binds a 2D texture to a texture unit, activating the unit only if the texture changes
+		ARGUMENTS:
+		-	uint a_uUnit -> texture unit, 0 for GL_TEXTURE0
+		-	GLuint a_uTexture -> texture to bind
+		-	bool a_bActive = false -> leave the unit active even if the texture was bound already, for
+			code that changes the texture after binding it
+		OUTPUT: ---
+		*/
+		void BindTexture(uint a_uUnit, GLuint a_uTexture, bool a_bActive = false);
+		/*
+		USAGE: glPolygonMode for both faces if the mode changes
+		ARGUMENTS: GLenum a_eMode -> GL_FILL, GL_LINE or GL_POINT
+		OUTPUT: ---
+		*/
+		void SetPolygonMode(GLenum a_eMode);
+		/*
+		USAGE: glPolygonOffset if the offset changes
+		ARGUMENTS:
+		-	float a_fFactor -> scale of the depth slope
+		-	float a_fUnits -> constant depth offset
+		OUTPUT: ---
+		*/
+		void SetPolygonOffset(float a_fFactor, float a_fUnits);
+		/*
+		USAGE: glEnable/glDisable if the capability changes, capabilities the manager does not know
+			about are always sent
+		ARGUMENTS:
+		-	GLenum a_eCapability -> GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST or
+			GL_POLYGON_OFFSET_LINE
+		-	bool a_bEnable -> enable or disable
+		OUTPUT: ---
+		*/
+		void SetCapability(GLenum a_eCapability, bool a_bEnable);
+		/*
+		USAGE: Asks if a capability is enabled, the driver is only asked when the manager does not know
+		ARGUMENTS: GLenum a_eCapability -> OpenGL capability
+		OUTPUT: enabled?
+		*/
+		bool IsCapabilityEnabled(GLenum a_eCapability);
+		/*
+		USAGE: glBlendFunc if the function changes, the same factors are used for color and alpha
+		ARGUMENTS:
+		-	GLenum a_eSource -> source factor
+		-	GLenum a_eDestination -> destination factor
+		OUTPUT: ---
+		*/
+		void SetBlendFunc(GLenum a_eSource, GLenum a_eDestination);
+		/*
+		USAGE: Gets the blend function, the driver is only asked when the manager does not know
+		ARGUMENTS:
+		-	GLenum& a_eSource -> (output) source factor
+		-	GLenum& a_eDestination -> (output) destination factor
+		OUTPUT: ---
+		*/
+		void GetBlendFunc(GLenum& a_eSource, GLenum& a_eDestination);
+		/*
+		USAGE: glBlendEquation if the equation changes
+		ARGUMENTS: GLenum a_eEquation -> blend equation
+		OUTPUT: ---
+		*/
+		void SetBlendEquation(GLenum a_eEquation);
+		/*
+		USAGE: Gets the blend equation, the driver is only asked when the manager does not know
+		ARGUMENTS: ---
+		OUTPUT: blend equation
+		*/
+		GLenum GetBlendEquation(void);
+		/*
+		USAGE: glViewport if the viewport changes
+		ARGUMENTS:
+		-	GLint a_nX -> left of the viewport
+		-	GLint a_nY -> bottom of the viewport
+		-	GLsizei a_nWidth -> width of the viewport
+		-	GLsizei a_nHeight -> height of the viewport
+		OUTPUT: ---
+		*/
+		void SetViewport(GLint a_nX, GLint a_nY, GLsizei a_nWidth, GLsizei a_nHeight);
+		/*
+		USAGE: Gets the viewport, the driver is only asked when the manager does not know
+		ARGUMENTS: GLint* a_nViewport -> (output) array of 4, x, y, width and height
+		OUTPUT: ---
+		*/
+		void GetViewport(GLint* a_nViewport);
+		/*
+		USAGE: glScissor if the scissor box changes
+		ARGUMENTS:
+		-	GLint a_nX -> left of the box
+		-	GLint a_nY -> bottom of the box
+		-	GLsizei a_nWidth -> width of the box
+		-	GLsizei a_nHeight -> height of the box
+		OUTPUT: ---
+		*/
+		void SetScissor(GLint a_nX, GLint a_nY, GLsizei a_nWidth, GLsizei a_nHeight);
+		/*
+		USAGE: Gets the scissor box, the driver is only asked when the manager does not know
+		ARGUMENTS: GLint* a_nScissor -> (output) array of 4, x, y, width and height
+		OUTPUT: ---
+		*/
+		void GetScissor(GLint* a_nScissor);
+		/*
+		USAGE: Forgets the program if it is the one in use, call it before deleting a program
+		ARGUMENTS: GLuint a_uProgram -> program about to be deleted
+		OUTPUT: ---
+		*/
+		void ForgetProgram(GLuint a_uProgram);
+		/*
+		USAGE: Forgets the vertex array if it is bound, call it before deleting a vertex array
+		ARGUMENTS: GLuint a_uVertexArray -> vertex array about to be deleted
+		OUTPUT: ---
+		*/
+		void ForgetVertexArray(GLuint a_uVertexArray);
+		/*
+		USAGE: Forgets the texture in every unit it is bound to, call it before deleting a texture
+		ARGUMENTS: GLuint a_uTexture -> texture about to be deleted
+		OUTPUT: ---
+		*/
+		void ForgetTexture(GLuint a_uTexture);
+		/*
+		USAGE: Forgets all the state, for code that changed it without going through the manager
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Invalidate(void);
+		/*
+		USAGE: Closes the frame, the counts of the frame become the last frame's and start over
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ResetCounters(void);
+		/*
+		USAGE: Number of state calls sent to the driver the last frame
+		ARGUMENTS: ---
+		OUTPUT: call count
+		*/
+		uint GetCallCount(void);
+		/*
+		USAGE: Number of state calls skipped the last frame because they would not change anything
+		ARGUMENTS: ---
+		OUTPUT: saved call count
+		*/
+		uint GetSavedCount(void);
+
+	private:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		GLStateManager(void);
+		/*
+		USAGE: Copy Constructor
+		ARGUMENTS: other -> object to copy
+		OUTPUT: ---
+		*/
+		GLStateManager(GLStateManager const& other);
+		/*
+		USAGE: Copy Assignment Operator
+		ARGUMENTS: other -> object to copy
+		OUTPUT: ---
+		*/
+		GLStateManager& operator=(GLStateManager const& other);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~GLStateManager(void);
+		/*
+		USAGE: Initializes the objects fields
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Init(void);
+		/*
+		USAGE: Releases the objects memory
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Release(void);
+		/*
+		USAGE: Index of a capability in the capability array
+		ARGUMENTS: GLenum a_eCapability -> OpenGL capability
+		OUTPUT: index, CAPABILITY_COUNT if the manager does not know about it
+		*/
+		static uint GetCapabilityIndex(GLenum a_eCapability);
+	};
+
+} //namespace BasicX
+
+#endif //__GLSTATEMANAGER_H_
@@ -49,12 +49,23 @@ public:
 	*/
 	void Swap(Shader& other);
 	/*
-	USAGE:
+	USAGE: Compiles the vertex and fragment shader files into a program, reusing the program binary
+		saved next to the shaders when the code and the driver did not change
 	ARGUMENTS:
-	OUTPUT:
+		String a_sVertexShader -> vertex shader file
+		String a_sFragmentShader -> fragment shader file
+		String a_sName = "" -> name of the program, the file names if empty
+	OUTPUT: OpenGL identifier of the program, 0 if it did not compile
 	*/
 	GLuint CompileShader(String a_sVertexShader, String a_sFragmentShader, String a_sName = "");
 	/*
+	USAGE: Compiles the shader files again and relinks the program in place, the identifier does not
+		change and if the new code does not compile the program keeps the old one
+	ARGUMENTS: ---
+	OUTPUT: the new code is in use
+	*/
+	bool Reload(void);
+	/*
 	USAGE:
 	ARGUMENTS: ---
 	OUTPUT:
@@ -92,7 +103,12 @@ protected:
 	OUTPUT: ---
 	*/
 	void Init(void);
-	
+	/*
+	USAGE: Gets the file the program binary is cached in, next to the fragment shader
+	ARGUMENTS: ---
+	OUTPUT: file name
+	*/
+	String GetBinaryFileName(void);
 };
 
 EXPIMP_TEMPLATE template class BasicXDLL std::vector<Shader>;
@@ -18,6 +18,53 @@ ARGUMENTS:
 OUTPUT:
 */
 BasicXDLL GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_path);
+/*
+USAGE: Reads a whole shader file into a string
+ARGUMENTS:
+	const char * file_path -> file to read
+	std::string& code -> where the contents are stored
+OUTPUT: the file could be opened
+*/
+BasicXDLL bool ReadShaderFile(const char * file_path, std::string& code);
+/*
+USAGE: Compiles the vertex and fragment code and links them into a program, if a target program
+	is given it is relinked only when the new code links, keeping its identifier
+ARGUMENTS:
+	const std::string& vertex_code -> vertex shader code
+	const std::string& fragment_code -> fragment shader code
+	const char * vertex_file_path -> vertex shader file, for the error log
+	const char * fragment_file_path -> fragment shader file, for the error log
+	GLuint target_program = 0 -> program to relink, 0 to create a new one
+OUTPUT: program identifier, 0 if the code did not compile or link
+*/
+BasicXDLL GLuint CompileProgram(const std::string& vertex_code, const std::string& fragment_code,
+	const char * vertex_file_path, const char * fragment_file_path, GLuint target_program = 0);
+/*
+USAGE: Hashes the shader code together with the driver strings, a binary is only valid for the
+	same code on the same driver
+ARGUMENTS:
+	const std::string& vertex_code -> vertex shader code
+	const std::string& fragment_code -> fragment shader code
+OUTPUT: hash
+*/
+BasicXDLL unsigned long long HashShaderSource(const std::string& vertex_code, const std::string& fragment_code);
+/*
+USAGE: Creates a program from a binary saved by SaveProgramBinary
+ARGUMENTS:
+	const char * binary_file_path -> binary file
+	unsigned long long source_hash -> hash of the code the binary has to come from
+OUTPUT: program identifier, 0 if there is no binary, it is stale or the driver rejects it
+*/
+BasicXDLL GLuint LoadProgramBinary(const char * binary_file_path, unsigned long long source_hash);
+/*
+USAGE: Saves the binary of a linked program, does nothing if the driver has no binary formats
+ARGUMENTS:
+	GLuint program -> linked program
+	const char * binary_file_path -> binary file
+	unsigned long long source_hash -> hash of the code of the program
+OUTPUT: the binary was saved
+*/
+BasicXDLL bool SaveProgramBinary(GLuint program, const char * binary_file_path, unsigned long long source_hash);
 
 
 #endif //__SHADER_H__
@@ -9,6 +9,11 @@ Date: 2015/06
 #include <vector>
 #include <assert.h>
 #include <map>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <ctime>
 namespace BasicX
 {
 
@@ -22,6 +27,23 @@ class BasicXDLL ShaderManager
 	std::vector<Shader> m_vShader; //vector of shaders
 	std::map<String, int> m_map;//Indexer of Shaders
 
+	//files the hot reload watches for each shader, only touched by the watcher once added
+	struct ShaderFiles
+	{
+		String m_sVertex; //vertex shader file
+		String m_sFragment; //fragment shader file
+		time_t m_tVertex; //last time the vertex shader was modified
+		time_t m_tFragment; //last time the fragment shader was modified
+	};
+	std::vector<ShaderFiles> m_watchList; //files of each shader, same order as m_vShader
+	std::set<uint> m_changedSet; //shaders whose files changed and need to be reloaded
+	std::thread m_watcher; //checks the shader files in the background
+	std::mutex m_mutex; //guards the watch list and the changed set
+	std::condition_variable m_condition; //wakes the watcher to stop it
+	bool m_bWatching = false; //the watcher thread is running
+	bool m_bStopWatcher = false; //asks the watcher thread to finish
+	uint m_uReloadCount = 0; //programs relinked by Update so far
+
 public:
 	/* Singleton accessor */
 	/*
@@ -76,6 +98,34 @@ public:
 	OUTPUT:
 	*/
 	int IdentifyShader(String a_sName);
+	/*
+	USAGE: Starts or stops watching the shader files, changed files get recompiled by Update; only the
+		watching runs in the background, compiling and linking need the OpenGL context of the main thread
+	ARGUMENTS:
+		bool a_bHotReload -> watch the files
+	OUTPUT: ---
+	*/
+	void SetHotReload(bool a_bHotReload);
+	/*
+	USAGE: Asks if the shader files are being watched
+	ARGUMENTS: ---
+	OUTPUT: watching?
+	*/
+	bool IsHotReload(void);
+	/*
+	USAGE: Reloads the shaders whose files changed, needs to be called from the main thread; the
+		identifiers of the programs do not change but the locations of their uniforms may, code that
+		keeps them has to ask again when GetReloadCount changes
+	ARGUMENTS: ---
+	OUTPUT: number of shaders reloaded
+	*/
+	uint Update(void);
+	/*
+	USAGE: Number of programs relinked by Update so far
+	ARGUMENTS: ---
+	OUTPUT: reload count
+	*/
+	uint GetReloadCount(void);
 
 private:
 	/* Constructor */
@@ -131,6 +181,13 @@ private:
 	OUTPUT: ---
 	*/
 	void Init(void);
+	/*
+	USAGE: Polls the modification time of the shader files until asked to stop, runs on the
+		watcher thread
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void WatchFiles(void);
 };
 
 }
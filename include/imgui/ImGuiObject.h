@@ -29,6 +29,12 @@ struct ImGuiObject
 	double m_dTimeTotal = 0.0f; //Time
 	bool m_bMousePressed[3] = { false, false, false }; //flags for mouse
 	GLuint m_uFontTexture = 0; //Font texture
+
+	GLsizeiptr m_nVBOSize = 0; //bytes allocated for the vertex buffer, grows to the largest frame
+	GLsizeiptr m_nElementsSize = 0; //bytes allocated for the elements buffer, grows to the largest frame
+
+	unsigned int m_uRenderClock = 0; //Clock to time the rendering of the gui
+	double m_dRenderTime = 0.0; //CPU time spent rendering the gui last frame, in milliseconds
 };
 
 #endif //__IMGUIOBJECT_H_
\ No newline at end of file